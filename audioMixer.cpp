@@ -0,0 +1,258 @@
+#include "audioMixer.h"
+#include <iostream>
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define MIXER_USE_SSE
+#endif
+
+namespace {
+	const char* cueFiles[cueCount] = { "sourceAudio/mark.wav", "sourceAudio/aiMove.wav", "sourceAudio/boardWon.wav",
+									   "sourceAudio/boardExpired.wav", "sourceAudio/lifeLost.wav" };
+
+	// Fallback tones when a wav is missing: start pitch, end pitch (Hz) and length (seconds)
+	const float cueTones[cueCount][3] = { { 880.0f, 880.0f, 0.06f },
+										  { 660.0f, 660.0f, 0.06f },
+										  { 523.0f, 1046.0f, 0.15f },
+										  { 440.0f, 220.0f, 0.20f },
+										  { 150.0f, 110.0f, 0.25f } };
+
+	const float pi = 3.14159265f;
+}
+
+AudioMixer::AudioMixer() : device(0), frequency(preferredFrequency), bufferSize(bufferFrames), queueHead(0), queueTail(0) {
+	for (int i = 0; i < cueCount; i++) {
+		samples[i].data = NULL;
+		samples[i].length = 0;
+	}
+	for (int i = 0; i < maxVoices; i++) {
+		voices[i].data = NULL;
+	}
+}
+
+AudioMixer::~AudioMixer() {
+	close();
+}
+
+bool AudioMixer::open() {
+	SDL_AudioSpec desired;
+	SDL_AudioSpec obtained;
+	SDL_memset(&desired, 0, sizeof(desired));
+	desired.freq = preferredFrequency;
+	desired.format = AUDIO_F32SYS;
+	desired.channels = 1;
+	desired.samples = bufferFrames;
+	desired.callback = audioCallback;
+	desired.userdata = this;
+
+	// Format, channels and buffer size are fixed so the callback can mix straight into a small stream, SDL converts
+	// and rebuffers if the hardware wants something else
+	device = SDL_OpenAudioDevice(NULL, 0, &desired, &obtained, SDL_AUDIO_ALLOW_FREQUENCY_CHANGE);
+	if (device == 0) {
+		std::cout << "Could not open audio, playing without sound. Error: " << SDL_GetError() << std::endl;
+		return false;
+	}
+	frequency = obtained.freq;
+	bufferSize = obtained.samples;
+
+	// Decode everything now, the callback only ever reads these
+	for (int i = 0; i < cueCount; i++) {
+		if (!loadSample((soundCue)i, cueFiles[i])) {
+			synthesizeSample((soundCue)i);
+		}
+	}
+
+	std::cout << "Audio: " << SDL_GetCurrentAudioDriver() << " at " << frequency << "Hz, " << bufferSize
+		<< " frame buffer, " << getLatencyMs() << "ms worst case cue latency" << std::endl;
+	if (getLatencyMs() > latencyBudgetMs) {
+		std::cout << "Warning: audio latency is over the " << latencyBudgetMs << "ms budget, cues will lag behind the game" << std::endl;
+	}
+
+	SDL_PauseAudioDevice(device, 0);
+	return true;
+}
+
+void AudioMixer::close() {
+	if (device != 0) {
+		// Closing waits for the callback to finish, so the samples are safe to free afterwards
+		SDL_CloseAudioDevice(device);
+		device = 0;
+	}
+
+	for (int i = 0; i < cueCount; i++) {
+		SDL_free(samples[i].data);
+		samples[i].data = NULL;
+		samples[i].length = 0;
+	}
+}
+
+void AudioMixer::play(soundCue cue, float volume) {
+	if (device == 0) {
+		return;
+	}
+
+	unsigned int tail = queueTail.load(std::memory_order_relaxed);
+	if (tail - queueHead.load(std::memory_order_acquire) == queueSize) {
+		return; // Full, the cue would be late anyway so drop it
+	}
+
+	queue[tail & (queueSize - 1)].cue = cue;
+	queue[tail & (queueSize - 1)].volume = volume;
+	queueTail.store(tail + 1, std::memory_order_release);
+}
+
+// A command can wait up to one buffer for the next callback, and then plays out through one more. Whatever the
+// driver queues after that isn't visible through SDL, so this is a floor rather than the full picture
+float AudioMixer::getLatencyMs() const {
+	return 2.0f * bufferSize * 1000.0f / frequency;
+}
+
+int AudioMixer::queuedCues() const {
+	return (int)(queueTail.load(std::memory_order_acquire) - queueHead.load(std::memory_order_acquire));
+}
+
+void AudioMixer::audioCallback(void* userdata, Uint8* stream, int len) {
+	AudioMixer* mixer = (AudioMixer*)userdata;
+	mixer->startVoices();
+	mixer->mix((float*)stream, len / (int)sizeof(float));
+}
+
+// Audio thread. Turn queued commands into voices, stealing the one closest to finishing if they're all busy
+void AudioMixer::startVoices() {
+	unsigned int head = queueHead.load(std::memory_order_relaxed);
+	unsigned int tail = queueTail.load(std::memory_order_acquire);
+
+	while (head != tail) {
+		const PlayCommand& command = queue[head & (queueSize - 1)];
+		const Sample& sample = samples[command.cue];
+
+		if (sample.data) {
+			int chosen = 0;
+			for (int i = 0; i < maxVoices; i++) {
+				if (!voices[i].data) {
+					chosen = i;
+					break;
+				}
+				if (voices[i].length - voices[i].position < voices[chosen].length - voices[chosen].position) {
+					chosen = i;
+				}
+			}
+
+			voices[chosen].data = sample.data;
+			voices[chosen].length = sample.length;
+			voices[chosen].position = 0;
+			voices[chosen].volume = command.volume;
+		}
+
+		head++;
+	}
+
+	queueHead.store(head, std::memory_order_release);
+}
+
+// Audio thread. SDL doesn't clear the stream for us, so every frame gets written
+void AudioMixer::mix(float* out, int frames) {
+	std::memset(out, 0, frames * sizeof(float));
+
+	for (int v = 0; v < maxVoices; v++) {
+		Voice& voice = voices[v];
+		if (!voice.data) {
+			continue;
+		}
+
+		int count = voice.length - voice.position;
+		if (count > frames) {
+			count = frames;
+		}
+		const float* source = voice.data + voice.position;
+
+		int i = 0;
+#ifdef MIXER_USE_SSE
+		__m128 gain = _mm_set1_ps(voice.volume);
+		for (; i + 4 <= count; i += 4) {
+			__m128 mixed = _mm_add_ps(_mm_loadu_ps(out + i), _mm_mul_ps(_mm_loadu_ps(source + i), gain));
+			_mm_storeu_ps(out + i, mixed);
+		}
+#endif
+		for (; i < count; i++) {
+			out[i] += source[i] * voice.volume;
+		}
+
+		voice.position += count;
+		if (voice.position >= voice.length) {
+			voice.data = NULL;
+		}
+	}
+
+	// Clip so stacked voices don't wrap around
+	int i = 0;
+#ifdef MIXER_USE_SSE
+	__m128 low = _mm_set1_ps(-1.0f);
+	__m128 high = _mm_set1_ps(1.0f);
+	for (; i + 4 <= frames; i += 4) {
+		_mm_storeu_ps(out + i, _mm_min_ps(_mm_max_ps(_mm_loadu_ps(out + i), low), high));
+	}
+#endif
+	for (; i < frames; i++) {
+		out[i] = out[i] < -1.0f ? -1.0f : (out[i] > 1.0f ? 1.0f : out[i]);
+	}
+}
+
+// Decode a wav into mono floats at the device's rate
+bool AudioMixer::loadSample(soundCue cue, const char* fileName) {
+	SDL_AudioSpec wavSpec;
+	Uint8* wavBuffer;
+	Uint32 wavLength;
+	if (!SDL_LoadWAV(fileName, &wavSpec, &wavBuffer, &wavLength)) {
+		return false;
+	}
+
+	SDL_AudioCVT converter;
+	if (SDL_BuildAudioCVT(&converter, wavSpec.format, wavSpec.channels, wavSpec.freq, AUDIO_F32SYS, 1, frequency) < 0) {
+		SDL_FreeWAV(wavBuffer);
+		return false;
+	}
+
+	converter.len = wavLength;
+	converter.buf = (Uint8*)SDL_malloc(wavLength * converter.len_mult);
+	if (!converter.buf) {
+		SDL_FreeWAV(wavBuffer);
+		return false;
+	}
+	std::memcpy(converter.buf, wavBuffer, wavLength);
+	SDL_FreeWAV(wavBuffer);
+
+	if (SDL_ConvertAudio(&converter) < 0) {
+		SDL_free(converter.buf);
+		return false;
+	}
+
+	samples[cue].data = (float*)converter.buf;
+	samples[cue].length = converter.len_cvt / (int)sizeof(float);
+	return true;
+}
+
+// A decaying sine sweep, good enough to tell the cues apart
+void AudioMixer::synthesizeSample(soundCue cue) {
+	float startPitch = cueTones[cue][0];
+	float endPitch = cueTones[cue][1];
+	int length = (int)(cueTones[cue][2] * frequency);
+
+	float* data = (float*)SDL_malloc(length * sizeof(float));
+	if (!data) {
+		return;
+	}
+
+	float phase = 0.0f;
+	for (int i = 0; i < length; i++) {
+		float t = (float)i / length;
+		float pitch = startPitch + (endPitch - startPitch) * t;
+		phase += 2.0f * pi * pitch / frequency;
+		data[i] = 0.4f * std::sin(phase) * (1.0f - t) * (1.0f - t);
+	}
+
+	samples[cue].data = data;
+	samples[cue].length = length;
+}
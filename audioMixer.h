@@ -0,0 +1,91 @@
+#pragma once
+
+#ifndef AUDIO_MIXER_H
+#define AUDIO_MIXER_H
+
+#include <SDL.h>
+#include <atomic>
+
+/*
+	Small mixer for the game's sound cues, running in SDL's audio callback.
+
+	- Every cue is decoded once on open() into a float buffer at the device's rate. If the wav isn't in
+	  sourceAudio/ a short tone is synthesized instead, so the game never goes silent over missing files
+	- play() is called from the game thread and only pushes a command onto a single-producer/single-consumer
+	  ring. The callback drains it, so neither side ever locks, and the callback never allocates
+	- Voices are mixed with SSE where it's available
+
+	The buffer is kept small (256 frames) so a cue is heard within a couple of callbacks, well inside the 20ms
+	latency budget. open() warns if the device can't get there. Set SDL_AUDIODRIVER to "dummy" or "disk" to run
+	without a sound card, tools/audioCheck.cpp does exactly that.
+*/
+
+enum soundCue { cuePlayerMark, cueAIMove, cueBoardWon, cueBoardExpired, cueLifeLost, cueCount };
+
+class AudioMixer {
+public:
+	AudioMixer();
+	~AudioMixer();
+
+	// Opens the audio device and decodes every cue. Returns false if there's no audio, the game carries on without it
+	bool open();
+	void close();
+	bool isOpen() const { return device != 0; }
+
+	// Game thread only
+	void play(soundCue cue, float volume = 1.0f);
+
+	// Worst case time from play() to the cue starting, in milliseconds. The driver's own queue comes on top of this
+	float getLatencyMs() const;
+	static constexpr float latencyBudgetMs = 20.0f;
+
+	// Cues played but not yet picked up by the audio callback
+	int queuedCues() const;
+
+private:
+	static const int maxVoices = 16;
+	static const int queueSize = 64; // Must be a power of two
+	static const int bufferFrames = 256;
+	static const int preferredFrequency = 48000;
+
+	struct Sample {
+		float* data;
+		int length;
+	};
+
+	struct Voice {
+		const float* data;
+		int length;
+		int position;
+		float volume;
+	};
+
+	struct PlayCommand {
+		soundCue cue;
+		float volume;
+	};
+
+	SDL_AudioDeviceID device;
+	int frequency;
+	int bufferSize;
+
+	// Decoded cues, owned by the mixer
+	Sample samples[cueCount];
+
+	// Only touched by the audio thread
+	Voice voices[maxVoices];
+
+	// Command ring. The game thread writes the tail, the audio thread writes the head
+	PlayCommand queue[queueSize];
+	std::atomic<unsigned int> queueHead;
+	std::atomic<unsigned int> queueTail;
+
+	static void audioCallback(void* userdata, Uint8* stream, int len);
+	void startVoices();
+	void mix(float* out, int frames);
+
+	bool loadSample(soundCue cue, const char* fileName);
+	void synthesizeSample(soundCue cue);
+};
+
+#endif // !AUDIO_MIXER_H
@@ -1,4 +1,5 @@
 #include "board.h"
+#include "resourceTracker.h"
 //#include <chrono.h>
 
 /*
@@ -14,52 +15,45 @@
 
 */
 
-void Board::setPositionStart(int x, int y, int w, int h) {
-	positionStart.x = x;
-	positionStart.y = y;
-	positionStart.w = w;
-	positionStart.h = h;
-}
-
+// The drawn position doubles as the corner coords used for comparing mouseX and mouseY
 void Board::setPositionEnd(int x, int y, int w, int h) {
-	positionEnd.x = x;
-	positionEnd.y = y;
-	positionEnd.w = w;
-	positionEnd.h = h;
+	positionX = (int16_t)x;
+	positionY = (int16_t)y;
+	positionW = (int16_t)w;
+	positionH = (int16_t)h;
 }
 
-// Corner coords used for comparing mouseX and mouseY
-void Board::setCornerCoords(int x1, int y1, int x2, int y2) {
-	leftX = x1;
-	leftY = y1;
-	rightX = x2;
-	rightY = y2;
+void Board::initializeTime(float currentTime, float speedMod) {
+	timeStart = currentTime;
+	timeEnd = timeStart + (duration * (1 / speedMod));
 }
 
-void Board::initializeTime(float speedMod) {
-	timeStart = (float)SDL_GetTicks() / 1000;
-	timeEnd = timeStart + (duration * (1 / speedMod));
+// Sets a marker value on the board
+void Board::setBoardMarker(int x, int y, int marker) {
+	boardGrid[x][y] = (int8_t)marker;
 }
 
-// Sets the sprite for the board
-void Board::setSprite(std::string fileName, SDL_Renderer* renderer) {
-	SDL_Surface* surface;
-	surface = IMG_Load("sourceImages/board.jpg");
-	if (!surface) {
-		std::cout << "no image, bud: " << IMG_GetError();
+bool Board::tryPlayerMove(int x, int y) {
+	if (boardGrid[x][y] != -1) {
+		return false; // Can't set marker in that location
 	}
-	boardTexture = SDL_CreateTextureFromSurface(renderer, surface);
-}
 
-// Sets a marker value on the board
-void Board::setBoardMarker(int x, int y, int marker) {
-	boardGrid[x][y] = marker;
+	setBoardMarker(x, y, xMarker);
+	incrementTurn();
+	setAITurn();
+	return true;
 }
 
 bool Board::canDecideNextMove() {
+	TRACK_SUBSYSTEM(subsystemAI);
+
 	int xInLineCount = 0;
 	int oInLineCount = 0;
-	std::vector<int> prioritySquare;
+	int prioritySquare[2] = { -1, -1 }; // Last empty square seen in the current line, -1 if the line is full
+
+	// Candidate squares for the AI's next move, one per solution line at most
+	int aIMovePriority[solutionsTotal][2];
+	int aIMovePriorityCount = 0;
 
 	// Handling potential high-priority lines
 
@@ -70,7 +64,8 @@ bool Board::canDecideNextMove() {
 			//		xMarker = 0 , oMarker = 1
 			switch (boardGrid[solutions[i][j][0]][solutions[i][j][1]]) {
 			case -1: // Empty space
-				prioritySquare = { solutions[i][j][0], solutions[i][j][1] };
+				prioritySquare[0] = solutions[i][j][0];
+				prioritySquare[1] = solutions[i][j][1];
 				break;
 			case 0: // X Marker
 				xInLineCount++;
@@ -103,31 +98,30 @@ bool Board::canDecideNextMove() {
 		else if (xInLineCount == 2 && oInLineCount == 0) {
 			// If the amount of x's in this line is equal to or greater than the max, push this spot onto priority map or increment it if it already exists
 			// The priority square is the only place in solution line that could be moved to
-			aIMovePriority.push_back(prioritySquare);
 			boardGrid[prioritySquare[0]][prioritySquare[1]] = oMarker;
 			incrementTurn(); // Increment the turn count
 			// Pass turn back to player
 			setPlayerTurn();
 			return true;
 		}
-		else {
+		else if (prioritySquare[0] != -1) {
 			// No pressing need, push an empty square onto low priority stack
-			aIMovePriority.push_back(prioritySquare);
+			aIMovePriority[aIMovePriorityCount][0] = prioritySquare[0];
+			aIMovePriority[aIMovePriorityCount][1] = prioritySquare[1];
+			aIMovePriorityCount++;
 		}
 
-		// Reset the line counters for a new solution
+		// Reset the line counters and empty square for a new solution
 		xInLineCount = 0;
 		oInLineCount = 0;
+		prioritySquare[0] = prioritySquare[1] = -1;
 	}
 
-	srand(time(NULL));
-
 	// Create a random number based on the number of positions in the priority vector
-	int randomSquare = rand() % aIMovePriority.size();
-	boardGrid[aIMovePriority[randomSquare][0]][aIMovePriority[randomSquare][1]] = 1; // Pick a random low-priority square to place a circle
-	aIMovePriority.clear(); // Clear this turns AI queue
+	int randomSquare = rand() % aIMovePriorityCount;
+	boardGrid[aIMovePriority[randomSquare][0]][aIMovePriority[randomSquare][1]] = oMarker; // Pick a random low-priority square to place a circle
 	incrementTurn(); // Increment the turn count
-	if (turnCount >= 9) {
+	if (turnCount >= maxTurnCount) {
 		result = loss;
 		return false;	
 	}
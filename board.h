@@ -4,83 +4,71 @@
 #define BOARD_H
 
 #include <SDL.h>
-#include <SDL_image.h>
-#include <string>
-#include <iostream>
-#include <vector>
-#include <unordered_map>
+#include <stdint.h>
+#include <stdlib.h>
+#include <type_traits>
 #include <time.h>
 
-const enum turn { aITurn, playerTurn };
-const enum boardResult {win, loss};
+enum turn : uint8_t { aITurn, playerTurn };
+enum boardResult : uint8_t {win, loss};
+
+/*
+	Boards are plain records: the rule tables are shared static data, and everything a board owns fits in
+	well under a cache line with no pointers or heap memory. That makes them trivially copyable, so spawning,
+	copying, snapshotting or sending one is a single memcpy. The static_asserts below keep it that way.
+*/
 
 class Board {
 private:
-	// TODO: CHANGE "START" and "END" to SOURCE and DESTINATION. SOURCE REPRESENTS THE SOURCE IMAGE!
-	// Keeping track of the x/y position of the board
-	SDL_Rect positionStart;
-	SDL_Rect positionEnd;
-
-	// Initializing the initial size/position variables and the final size for boards
-	int initialX, initialY, finalX, finalY = 0;
-	int leftX, leftY, rightX, rightY;
-	const int finalW = 300;
-	const int finalH = 300;
-
-	SDL_Texture* boardTexture;
+	// Initializing the final size for boards. The source image is always the whole 300x300 board
+	static constexpr int finalW = 300;
+	static constexpr int finalH = 300;
 
 	// Game markers
-	const int xMarker = 0;
-	const int oMarker = 1;
-	turn boardTurn;
-	int turnCount = 0;
-	int maxTurnCount = 9;
-	boardResult result;
+	static constexpr int xMarker = 0;
+	static constexpr int oMarker = 1;
+	static constexpr int maxTurnCount = 9;
 
-	// Time variables
-	float duration = 5.0f;
-	float timeStart, timeEnd;
+	// Number of solutions
+	static constexpr int solutionsTotal = 8;
+	static constexpr int lineLength = 3;
 
 	// All possible winning solutions
-	const int solutions[8][3][2] = { { {0,2}, {1,2}, {2,2} },
-									 { {0,1}, {1,1}, {2,1} },
-									 { {0,0}, {1,0}, {2,0} },
-									 { {0,0}, {1,1}, {2,2} },
-									 { {0,0}, {0,1}, {0,2} },
-									 { {1,0}, {1,1}, {1,2} },
-									 { {2,0}, {2,1}, {2,2} },
-									 { {2,0}, {1,1}, {0,2} } };
-
-	std::vector<std::vector<std::vector<int>>> solutionsVectors { { {0,2}, {1,2}, {2,2} },
-																 { {0,1}, {1,1}, {2,1} },
-																 { {0,0}, {1,0}, {2,0} },
-																 { {0,0}, {1,1}, {2,2} },
-																 { {0,0}, {0,1}, {0,2} },
-																 { {1,0}, {1,1}, {1,2} },
-																 { {2,0}, {2,1}, {2,2} },
-																 { {2,0}, {1,1}, {0,2} } };
-
-	// This map's the solution indices with their frequency
-	std::unordered_map<int, int> solnPriorityMap;
-	//std::unordered_map<std::vector<int>, int> emptySqrPriorityMap;
-	std::vector<std::vector<int>> aIMovePriority;
-
-	// Number of solutions
-	const int solutionsTotal = 8;
-	const int lineLength = 3;
+	static constexpr int8_t solutions[8][3][2] = { { {0,2}, {1,2}, {2,2} },
+												   { {0,1}, {1,1}, {2,1} },
+												   { {0,0}, {1,0}, {2,0} },
+												   { {0,0}, {1,1}, {2,2} },
+												   { {0,0}, {0,1}, {0,2} },
+												   { {1,0}, {1,1}, {1,2} },
+												   { {2,0}, {2,1}, {2,2} },
+												   { {2,0}, {1,1}, {0,2} } };
 
 	// This is the array we will pull starting positions from using a MOD equation
-	const int positions[9][2] = { {0,0}, {1,0}, {2,0},
-								  {0,1}, {1,1}, {2,1},
-								  {0,2}, {1,2}, {2,2} };
-
-	// The grid used when setting up the board. -1 indicates an empty space
-	int boardGrid[3][3] = { {-1, -1, -1},
-							{-1, -1, -1},
-							{-1, -1, -1} };
-
-	// Grid used for public calls and game visuals
-	int grid[3][3];
+	static constexpr int8_t positions[9][2] = { {0,0}, {1,0}, {2,0},
+												{0,1}, {1,1}, {2,1},
+												{0,2}, {1,2}, {2,2} };
+
+	// Time variables. timeEnd is the real deadline, duration scaled down by the speed modifier
+	static constexpr float duration = 5.0f;
+	float timeStart = 0.0f;
+	float timeEnd = 0.0f;
+	int expiryTimer = -1; // Scheduler handle for the deadline
+
+	// Where the board is drawn this frame (x/y is the top left corner) and where it was spawned (its center)
+	int16_t positionX = 0, positionY = 0, positionW = 0, positionH = 0;
+	int16_t initialX = 0, initialY = 0;
+
+	// The board itself. -1 indicates an empty space
+	int8_t boardGrid[3][3] = { {-1, -1, -1},
+							   {-1, -1, -1},
+							   {-1, -1, -1} };
+	turn boardTurn = playerTurn;
+	boardResult result = loss;
+	uint8_t turnCount = 0;
+
+	// Occlusion results for this frame. One bit per cell, bit (x * 3 + y)
+	bool occluded = false;
+	uint16_t visibleCells = 0x1FF;
 
 public:
 	Board() {}
@@ -88,41 +76,46 @@ public:
 	// AI logic and calculator
 	bool canDecideNextMove();
 
+	// Place the player's marker if the cell is free, then hand the turn to the AI
+	bool tryPlayerMove(int x, int y);
+
 	// Initialize Values
-	void setInitialPos(int x, int y) { initialX = x; initialY = y; }
-	void initializeTime(float speedMod);
+	void setInitialPos(int x, int y) { initialX = (int16_t)x; initialY = (int16_t)y; }
+	void initializeTime(float currentTime, float speedMod);
 
-	// Getters and Setters
+	// Getters and Setters. The corners come straight from the drawn position
 	int getInitialX() const { return initialX; }
 	int getInitialY() const { return initialY; }
-	int getLeftX() const { return leftX; }
-	int getLeftY() const { return leftY; }
-	int getRightX() const { return rightX; }
-	int getRightY() const { return rightY; }
-	SDL_Rect getPositionStart() const { return positionStart; }
-	SDL_Rect getPositionEnd() const { return positionEnd; }
-	SDL_Texture* getTexture() const { return boardTexture; }
-	int getFinalWidth() const { return finalW; }
-	int getFinalHeight() const { return finalH; }
+	int getLeftX() const { return positionX; }
+	int getLeftY() const { return positionY; }
+	int getRightX() const { return positionX + positionW; }
+	int getRightY() const { return positionY + positionH; }
+	SDL_Rect getPositionStart() const { SDL_Rect rect = { 0, 0, finalW, finalH }; return rect; }
+	SDL_Rect getPositionEnd() const { SDL_Rect rect = { positionX, positionY, positionW, positionH }; return rect; }
+	static int getFinalWidth() { return finalW; }
+	static int getFinalHeight() { return finalH; }
 	float getTimeStart() const { return timeStart; }
 	float getTimeEnd() const { return timeEnd; }
-	float getDuration() const { return duration; }
+	static float getDuration() { return duration; }
 	int getBoardGrid(int x, int y) const { return boardGrid[x][y]; }
 	turn getBoardTurn() const { return boardTurn; }
 	boardResult getBoardResult() const { return result; }
 	int getTurnCount() const { return turnCount; }
+	int getExpiryTimer() const { return expiryTimer; }
+	bool isOccluded() const { return occluded; }
+	bool isCellVisible(int x, int y) const { return (visibleCells >> (x * 3 + y)) & 1; }
 
-	void setPositionStart(int x, int y, int w, int h);
 	void setPositionEnd(int x, int y, int w, int h);
-	void setCornerCoords(int x1, int y1, int x2, int y2);
-	void setSprite(std::string fileName, SDL_Renderer* renderer);
 	void setBoardMarker(int x, int y, int marker);
 	void setAITurn() { boardTurn = aITurn; }
 	void setPlayerTurn() { boardTurn = playerTurn; }
-	void incrementTurn() { turnCount++;
-	std::cout << turnCount << " turn(s) have passed" << std::endl;
-	}
-	// TODO: Get the current grid
+	void setExpiryTimer(int handle) { expiryTimer = handle; }
+	void setOccluded(bool isOccluded) { occluded = isOccluded; }
+	void setVisibleCells(int cells) { visibleCells = (uint16_t)cells; }
+	void incrementTurn() { turnCount++; }
 };
 
-#endif // !BOARD_H
\ No newline at end of file
+static_assert(std::is_trivially_copyable<Board>::value, "Boards must stay copyable with a memcpy");
+static_assert(sizeof(Board) <= 64, "Boards must fit in a cache line");
+
+#endif // !BOARD_H
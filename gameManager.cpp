@@ -1,6 +1,6 @@
 #include "gameManager.h"
 
-GameManager::GameManager() {
+GameManager::GameManager(float benchmarkSeconds) : benchmarkSeconds(benchmarkSeconds) {
 	// Make sure everything initializes correctly
 	if (SDL_Init(SDL_INIT_EVERYTHING) < 0) {
 		std::cout << "Could not initialize SDL. Error: " << SDL_GetError() << std::endl;
@@ -22,6 +22,9 @@ GameManager::GameManager() {
 	// Setup a time-based random variable
 	srand(time(NULL));
 
+	// Audio is optional, open() reports why if it fails
+	audioMixer.open();
+
 	// Setup game window
 	SDL_CreateWindowAndRenderer(windowWidth, windowHeight, 0, &window, &renderer);
 	SDL_SetWindowTitle(window, "Tic-Tac-TOLL-THE-DEAD");
@@ -29,35 +32,53 @@ GameManager::GameManager() {
 	// Set initial conditions
 	currentState = mainMenu; // game state
 	running = true; // game is running
-	spawnInterval = 4.0f; // Spawn interval for boards
+	spawnInterval = defaultSpawnInterval; // Spawn interval for boards
 
 	// Setup image for main menu
-	SDL_Surface* surface;
-	surface = IMG_Load(titleJPG.c_str());
-	if (!surface) {
-		std::cout << "no image, bud: " << IMG_GetError();
+	titleTex = loadTexture(titleJPG);
+
+	// A benchmark run has nobody to press a key, so skip the menu
+	if (benchmarkSeconds > 0.0f) {
+		gameStart();
 	}
-	titleTex = SDL_CreateTextureFromSurface(renderer, surface);
 
 	tick(); // Start ticking the frames
 }
 
 GameManager::~GameManager() {
+	// Clean up any boards that were still in play
+	while (boardCount > 0) {
+		deleteBoard(zBoard(boardCount - 1));
+	}
+
+	// Textures only exist once the game has started, except the title
+	SDL_Texture* textures[] = { titleTex, xTexture, oTexture, boardTex, boardMipTex[0], boardMipTex[1], livesTextTex, num5Tex, num4Tex, num3Tex, num2Tex, num1Tex };
+	for (SDL_Texture* texture : textures) {
+		if (texture) {
+			TRACK_DESTROY(resourceTexture, texture);
+			SDL_DestroyTexture(texture);
+		}
+	}
+
+	audioMixer.close();
+	qualityGovernor.report();
 	SDL_DestroyRenderer(renderer);
 	SDL_DestroyWindow(window);
-	SDL_Quit;
+	IMG_Quit();
+	SDL_Quit();
 }
 
 void GameManager::tick() {
 	// Use the game state to check if game is started
 	while (running) {
+		TRACK_FRAME();
+		Uint64 frameStart = SDL_GetPerformanceCounter();
+
 		switch (currentState) {
 		case mainMenu:
 			break;
 		case ticTacToe:
-			if (boardTimerIsReady()) {
-				spawnBoard();
-			}
+			processTimers();
 			break;
 		default:
 			break;
@@ -66,14 +87,46 @@ void GameManager::tick() {
 		renderFrame();
 		input();
 
+		if (benchmarkSeconds > 0.0f && currentState == ticTacToe) {
+			autoPlay();
+			running = running && runTime - gameStartTime < benchmarkSeconds;
+		}
+
+		// Let the governor adjust detail for the next frame
+		qualityGovernor.frameFinished((SDL_GetPerformanceCounter() - frameStart) * 1000.0f / SDL_GetPerformanceFrequency());
+
 		lastFrame = SDL_GetTicks();
 		runTime = (float)lastFrame / 1000.0f;
 	}
 }
 
-// Check whether it's ok to spawn another board
-bool GameManager::boardTimerIsReady() {
-	return runTime - lastBoardSpawn > spawnInterval;
+// Handle everything the scheduler says is due. Only due events cost anything, however many boards are out
+void GameManager::processTimers() {
+	TRACK_SUBSYSTEM(subsystemTick);
+
+	scheduledEvent type;
+	void* payload;
+	while (scheduler.popDue(runTime, type, payload)) {
+		switch (type) {
+		case eventSpawn:
+			spawnBoard();
+			scheduler.schedule(lastBoardSpawn + spawnInterval, eventSpawn, NULL);
+			break;
+		case eventWaveResume:
+			waveRunner.resume(payload);
+			break;
+		case eventBoardExpiry: {
+			// Ran out of time, costs a life
+			deleteBoard((Board*)payload);
+			playerLives--;
+			audioMixer.play(cueBoardExpired);
+			audioMixer.play(cueLifeLost);
+			break;
+		}
+		default:
+			break;
+		}
+	}
 }
 
 // Lerp function for interpolating the size of boards
@@ -82,6 +135,16 @@ float GameManager::lerp(float start, float end, float increment) {
 }
 
 void GameManager::renderFrame() {
+	TRACK_SUBSYSTEM(subsystemRender);
+
+	// Size every board from its timer, hidden boards included. Expired boards were already removed by the scheduler
+	for (int i = 0; i < boardCount; i++) {
+		layout(zBoard(i), lerp(0.0f, Board::getFinalWidth(), checkDuration(zBoard(i))));
+	}
+
+	// Work out what's hidden before drawing anything, the background fill can use it too
+	cullOccludedBoards();
+
 	// Set initial draw color (Black) and draw a rectangle
 	SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
 	SDL_Rect rect;
@@ -89,7 +152,17 @@ void GameManager::renderFrame() {
 	rect.w = windowWidth;
 	rect.h = windowHeight;
 
-	SDL_RenderFillRect(renderer, &rect);
+	// Under pressure only fill what the boards won't draw over anyway
+	int fillCount = -1;
+	if (qualityGovernor.getLevel() >= qualityReducedFill) {
+		fillCount = occlusionBuffer.uncoveredRects(fillRects, maxFillRects);
+	}
+	if (fillCount >= 0) {
+		SDL_RenderFillRects(renderer, fillRects, fillCount);
+	}
+	else {
+		SDL_RenderFillRect(renderer, &rect);
+	}
 
 	// Rects used for spawning various static images on screen
 	SDL_Rect startPos;
@@ -110,11 +183,13 @@ void GameManager::renderFrame() {
 	startPos.x = 0; startPos.y = 0; startPos.h = 100; startPos.w = 100;
 	endPos.x = 200; endPos.y = 500;; endPos.h = 100; endPos.w = 100;
 
+	// Several lives can go in one frame, so anything at or below 0 is game over. The benchmark keeps going so it covers the whole run
+	if (playerLives <= 0 && benchmarkSeconds <= 0.0f) {
+		running = false;
+	}
+
 	// Really bulky, but decide which "lives" jpg to use
 	switch (playerLives) {
-	case 0:
-		running = false;
-		break;
 	case 1:
 		SDL_RenderCopyEx(renderer, num1Tex, &startPos, &endPos, 0, NULL, SDL_FLIP_NONE);
 		break;
@@ -134,18 +209,10 @@ void GameManager::renderFrame() {
 		break;
 	}
 
-	// Set iterator to beginning of z-buffer and draw
-	zIterator = boardZBufferList.begin();
-
-	for (int i = 0; i < boardZBufferList.size(); i++) {
-		float incrementVal = checkDuration(*zIterator);
-		if (incrementVal <= 1) {
-			draw(*zIterator, lerp(0.0f, (*zIterator)->getFinalWidth(), incrementVal));
-			zIterator++;
-		}
-		else {
-			boardZBufferList.erase(zIterator);
-			playerLives--;
+	// Draw back-to-front skipping anything fully covered
+	for (int i = 0; i < boardCount; i++) {
+		if (!zBoard(i)->isOccluded()) {
+			draw(zBoard(i));
 		}
 	}
 
@@ -158,55 +225,150 @@ void GameManager::renderFrame() {
 }
 
 void GameManager::spawnBoard() {
-	Board* board = new Board;
-	board->initializeTime(speedMod);
-
 	// Create random values for the board's spawn points
 	// TODO: Apply some kind of additional modifier based on existing boards to minimize overlap?
-	int posX = rand() % (windowWidth - board->getFinalWidth()) + (board->getFinalWidth() / 2);
-	int posY = rand() % (windowHeight - board->getFinalHeight()) + (board->getFinalHeight() / 2);
+	int posX = rand() % (windowWidth - Board::getFinalWidth()) + (Board::getFinalWidth() / 2);
+	int posY = rand() % (windowHeight - Board::getFinalHeight()) + (Board::getFinalHeight() / 2);
+	spawnBoard(posX, posY);
+}
+
+void GameManager::spawnBoardAt(float x, float y) {
+	int posX = (int)(x * (windowWidth - Board::getFinalWidth())) + (Board::getFinalWidth() / 2);
+	int posY = (int)(y * (windowHeight - Board::getFinalHeight())) + (Board::getFinalHeight() / 2);
+	spawnBoard(posX, posY);
+}
+
+void GameManager::spawnBoard(int posX, int posY) {
+	TRACK_SUBSYSTEM(subsystemSpawn);
+
+	// Find a free slot, if the pool is full the screen is long since covered so skip this one
+	int slot = 0;
+	while (slot < maxBoards && boardInUse[slot]) {
+		slot++;
+	}
+	if (slot == maxBoards) {
+		lastBoardSpawn = runTime; // Still counts, so the fallback spawner waits a full interval before trying again
+		return;
+	}
+
+	// Copy a fresh record into the slot
+	Board* board = &boardPool[slot];
+	*board = Board();
+	boardInUse[slot] = true;
+	TRACK_CREATE(resourceBoard, board);
+	board->initializeTime(runTime, speedMod);
 
 	// Set board initial conditions
 	board->setInitialPos(posX, posY);
-	board->setPositionStart(0, 0, board->getFinalWidth(), board->getFinalHeight()); // Our source is the whole image
 	board->setPositionEnd(posX, posY, 0, 0);
-	board->setSprite(boardJPG, renderer);
 
 	// Pass turn to player
 	board->setPlayerTurn();
 
-	boardZBufferList.push_front(board);
+	// New boards go in at the back of the screen
+	for (int i = boardCount; i > 0; i--) {
+		boardZBuffer[i] = boardZBuffer[i - 1];
+	}
+	boardZBuffer[0] = slot;
+	boardCount++;
+	board->setExpiryTimer(scheduler.schedule(board->getTimeEnd(), eventBoardExpiry, board));
 
 	// Update last spawn time and increase speed for next board spawn
-	lastBoardSpawn = (float)SDL_GetTicks() / 1000;
-	speedMod = (runTime + speedRamping) / speedRamping;
+	lastBoardSpawn = runTime;
+	speedMod = speedModifier(runTime - gameStartTime, speedRamping);
 }
 
-// Check to see if the board has reached its max duration. Return value > 1 if true, else calculate the increment value to be used for the lerp
-float GameManager::checkDuration(Board* board) {
-	if (runTime > (board->getTimeStart() + board->getDuration())) {
-		return 2.0f;
+// Take the board out of the draw order, cancel its expiry and free its slot. Cancelling an expiry that
+// already fired does nothing, so this is safe for every board
+void GameManager::deleteBoard(Board* board) {
+	int slot = (int)(board - boardPool);
+
+	// Close the gap in the draw order
+	int i = 0;
+	while (i < boardCount && boardZBuffer[i] != slot) {
+		i++;
 	}
-	else {
-		return (runTime - board->getTimeStart()) / board->getDuration();
+	for (boardCount--; i < boardCount; i++) {
+		boardZBuffer[i] = boardZBuffer[i + 1];
 	}
+
+	scheduler.cancel(board->getExpiryTimer());
+	TRACK_DESTROY(resourceBoard, board);
+	boardInUse[slot] = false;
 }
 
-void GameManager::draw(Board* board, int adjustWAndH) {
-	// TODO: Grabbing the position values, changing them, then grabbing them again seems like too much.
-	//		- May just be trade off for changing the size
-	SDL_Rect positionStart = board->getPositionStart();
-	SDL_Rect positionEnd = board->getPositionEnd();
+// How far the board is through its speed-scaled lifetime, used as the increment for the lerp. Expiry itself is the scheduler's job
+float GameManager::checkDuration(Board* board) {
+	float progress = (runTime - board->getTimeStart()) / (board->getTimeEnd() - board->getTimeStart());
+	return progress > 1.0f ? 1.0f : progress;
+}
 
+void GameManager::layout(Board* board, int adjustWAndH) {
 	// Use the width/height of the square boards to offset the "spawn" location and keep track of the corners of the board
 	int positionOffset = adjustWAndH / 2;
 	board->setPositionEnd(board->getInitialX() - positionOffset, board->getInitialY() - positionOffset, adjustWAndH, adjustWAndH);
-	board->setCornerCoords(board->getInitialX() - positionOffset, board->getInitialY() - positionOffset, board->getInitialX() + positionOffset, board->getInitialY() + positionOffset);
+}
+
+// The back of the z-buffer is drawn last, so it's the front of the screen. Walk it front-to-back, marking
+// boards and marker cells that are completely covered by the boards in front of them
+void GameManager::cullOccludedBoards() {
+	occlusionBuffer.clear();
+
+	for (int z = boardCount - 1; z >= 0; z--) {
+		Board* board = zBoard(z);
+		SDL_Rect boardRect = board->getPositionEnd();
+
+		board->setOccluded(occlusionBuffer.isOccluded(boardRect));
+		if (board->isOccluded()) {
+			continue; // Already covered, so it adds nothing as an occluder either
+		}
 
-	positionEnd = board->getPositionEnd();
+		// Part of the board shows, but its markers may still be hidden
+		int cellUnit = boardRect.w / 3;
+		int visibleCells = 0;
+		SDL_Rect cellRect;
+		cellRect.w = cellUnit;
+		cellRect.h = cellUnit;
+		for (int i = 0; i < 3; i++) {
+			cellRect.x = board->getLeftX() + (i * cellUnit);
+			for (int j = 0; j < 3; j++) {
+				cellRect.y = board->getLeftY() + (j * cellUnit);
+				if (board->getBoardGrid(i, j) != -1 && !occlusionBuffer.isOccluded(cellRect)) {
+					visibleCells |= 1 << (i * 3 + j);
+				}
+			}
+		}
+		board->setVisibleCells(visibleCells);
+
+		occlusionBuffer.addOccluder(boardRect);
+	}
+}
+
+void GameManager::draw(Board* board) {
+	SDL_Rect positionStart = board->getPositionStart();
+	SDL_Rect positionEnd = board->getPositionEnd();
+	qualityLevel quality = qualityGovernor.getLevel();
+
+	// Small boards can use the smallest mip that's still at least their size
+	SDL_Texture* texture = boardTex;
+	if (quality >= qualityMipBoards) {
+		for (int i = boardMipCount - 1; i >= 0; i--) {
+			if (positionEnd.w <= boardMipSizes[i] && boardMipTex[i]) {
+				texture = boardMipTex[i];
+				positionStart.w = boardMipSizes[i];
+				positionStart.h = boardMipSizes[i];
+				break;
+			}
+		}
+	}
 
 	// Draw the background rectangle
-	SDL_RenderCopyEx(renderer, board->getTexture(), &positionStart, &positionEnd, 0, NULL, SDL_FLIP_NONE);
+	SDL_RenderCopyEx(renderer, texture, &positionStart, &positionEnd, 0, NULL, SDL_FLIP_NONE);
+
+	// Markers on tiny boards aren't worth the draw calls when we're behind
+	if (quality >= qualitySmallMarkers && positionEnd.w < QualityGovernor::markerMinBoardSize) {
+		return;
+	}
 
 	int cellUnit = board->getPositionEnd().w / 3;
 	positionStart.h = 100;
@@ -219,6 +381,9 @@ void GameManager::draw(Board* board, int adjustWAndH) {
 		positionEnd.x = board->getLeftX() + (i * cellUnit);
 		for (int j = 0; j < 3; j++) {
 			positionEnd.y = board->getLeftY() + (j * cellUnit);
+			if (!board->isCellVisible(i, j)) {
+				continue;
+			}
 			switch (board->getBoardGrid(i, j)) {
 			case 0:
 				SDL_RenderCopyEx(renderer, xTexture, &positionStart, &positionEnd, 0, NULL, SDL_FLIP_NONE);
@@ -241,83 +406,92 @@ void GameManager::draw(const char* message, int posX, int posY, int r, int g, in
 
 // Things to do when game starts
 void GameManager::gameStart() {
+	TRACK_SUBSYSTEM(subsystemLoading);
+
 	// Set up all the images used during runtime
-	SDL_Surface* surface;
-	surface = IMG_Load(xJPG.c_str());
-	if (!surface) {
-		std::cout << "no image, bud: " << IMG_GetError();
-	}
-	xTexture = SDL_CreateTextureFromSurface(renderer, surface);
+	xTexture = loadTexture(xJPG);
+	oTexture = loadTexture(oJPG);
+	boardTex = loadTexture(boardJPG);
+	createBoardMips();
+	livesTextTex = loadTexture(livesTextJPG);
+	num5Tex = loadTexture(fiveJPG);
+	num4Tex = loadTexture(fourJPG);
+	num3Tex = loadTexture(threeJPG);
+	num2Tex = loadTexture(twoJPG);
+	num1Tex = loadTexture(oneJPG);
+
+	// Set state to tictactoe and start spawning. The wave file drives it if there is one,
+	// otherwise spawn the first board and queue up the next one
+	currentState = ticTacToe;
+	gameStartTime = runTime;
+	bool hasWaves = waveRunner.load(wavesTXT, spawnInterval, speedRamping);
 
-	surface = IMG_Load(oJPG.c_str());
-	if (!surface) {
-		std::cout << "no image, bud: " << IMG_GetError();
-	}
-	oTexture = SDL_CreateTextureFromSurface(renderer, surface);
+	// Room for every board's expiry, each wave's next wake up and the fallback spawner, so play never grows the scheduler
+	scheduler.reserve(maxBoards + waveRunner.getWaveCount() + 1);
 
-	surface = IMG_Load(livesTextJPG.c_str());
-	if (!surface) {
-		std::cout << "no image, bud: " << IMG_GetError();
+	if (hasWaves) {
+		waveRunner.start(runTime);
 	}
-	livesTextTex = SDL_CreateTextureFromSurface(renderer, surface);
 
-	surface = IMG_Load(fiveJPG.c_str());
-	if (!surface) {
-		std::cout << "no image, bud: " << IMG_GetError();
+	// Waves that couldn't start leave nothing spawning, so fall back the same as having no file
+	if (waveRunner.getRunningCount() == 0) {
+		spawnBoard();
+		scheduler.schedule(lastBoardSpawn + spawnInterval, eventSpawn, NULL);
 	}
-	num5Tex = SDL_CreateTextureFromSurface(renderer, surface);
+}
 
-	surface = IMG_Load(fourJPG.c_str());
+SDL_Texture* GameManager::loadTexture(std::string fileName) {
+	SDL_Surface* surface = IMG_Load(fileName.c_str());
 	if (!surface) {
 		std::cout << "no image, bud: " << IMG_GetError();
+		return NULL;
 	}
-	num4Tex = SDL_CreateTextureFromSurface(renderer, surface);
+	TRACK_CREATE(resourceSurface, surface);
 
-	surface = IMG_Load(threeJPG.c_str());
-	if (!surface) {
-		std::cout << "no image, bud: " << IMG_GetError();
-	}
-	num3Tex = SDL_CreateTextureFromSurface(renderer, surface);
+	SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, surface);
+	TRACK_CREATE(resourceTexture, texture);
 
-	surface = IMG_Load(twoJPG.c_str());
-	if (!surface) {
-		std::cout << "no image, bud: " << IMG_GetError();
-	}
-	num2Tex = SDL_CreateTextureFromSurface(renderer, surface);
+	TRACK_DESTROY(resourceSurface, surface);
+	SDL_FreeSurface(surface);
+	return texture;
+}
 
-	surface = IMG_Load(oneJPG.c_str());
-	if (!surface) {
+void GameManager::createBoardMips() {
+	SDL_Surface* source = IMG_Load(boardJPG.c_str());
+	if (!source) {
 		std::cout << "no image, bud: " << IMG_GetError();
+		return;
 	}
-	num1Tex = SDL_CreateTextureFromSurface(renderer, surface);
+	TRACK_CREATE(resourceSurface, source);
 
+	for (int i = 0; i < boardMipCount; i++) {
+		SDL_Surface* mip = SDL_CreateRGBSurfaceWithFormat(0, boardMipSizes[i], boardMipSizes[i], 32, SDL_PIXELFORMAT_RGBA8888);
+		if (!mip) {
+			continue;
+		}
+		TRACK_CREATE(resourceSurface, mip);
 
-	// Set state to tictactoe and spawn first board
-	currentState = ticTacToe;
-	spawnBoard();
+		SDL_BlitScaled(source, NULL, mip, NULL);
+		boardMipTex[i] = SDL_CreateTextureFromSurface(renderer, mip);
+		TRACK_CREATE(resourceTexture, boardMipTex[i]);
+
+		TRACK_DESTROY(resourceSurface, mip);
+		SDL_FreeSurface(mip);
+	}
+
+	TRACK_DESTROY(resourceSurface, source);
+	SDL_FreeSurface(source);
 }
 
 Board* GameManager::intersectedBoard(int mouseX, int mouseY) {
-	// Make sure zBuffer has stuff before trying to do stuff with the board
-	if (boardZBufferList.size() == 0) {
-		return NULL;
-	}
-	
-	// In order to check stuff at the front FIRST, we need to reverse the ZBuffer
-	revZIterator = boardZBufferList.rbegin();
-
-	int x1 = (*revZIterator)->getLeftX();
-	int x2 = (*revZIterator)->getRightX();
-	int y1 = (*revZIterator)->getLeftY();
-	int y2 = (*revZIterator)->getRightY();
-
-	while (revZIterator != boardZBufferList.rend()) {
-		if (x1 < mouseX && mouseX < x2) {
-			if (y1 < mouseY && mouseY < y2) {
-				return *revZIterator;
+	// In order to check stuff at the front FIRST, walk the ZBuffer backwards
+	for (int i = boardCount - 1; i >= 0; i--) {
+		Board* board = zBoard(i);
+		if (board->getLeftX() < mouseX && mouseX < board->getRightX()) {
+			if (board->getLeftY() < mouseY && mouseY < board->getRightY()) {
+				return board;
 			}
 		}
-		revZIterator++;
 	}
 	return NULL;
 }
@@ -353,19 +527,14 @@ bool GameManager::canFillSpace(Board* board, int mouseX, int mouseY) {
 	}
 	
 	// Set the marker
-	if (board->getBoardGrid(xIndex, yIndex) == -1) {
-		board->setBoardMarker(xIndex, yIndex, xMarker);
-		board->incrementTurn();
-		board->setAITurn();
-		return true;
-	}
-	
-	return false; // Can't set marker in that location
+	return board->tryPlayerMove(xIndex, yIndex);
 }
 
 
 // Handling user input
 void GameManager::input() {
+	TRACK_SUBSYSTEM(subsystemInput);
+
 	SDL_Event inputEvent;
 	while (SDL_PollEvent(&inputEvent)) {
 		// Quit on ESCAPE
@@ -394,33 +563,7 @@ void GameManager::input() {
 				break;
 			case ticTacToe:
 				if (inputEvent.button.button == SDL_BUTTON_LEFT) {
-					Board* decideBoard = intersectedBoard(mouseX, mouseY);
-					if (decideBoard != NULL) {
-						// Only fill grid if it's the player's turn on that grid
-						if (decideBoard->getBoardTurn() == playerTurn) {
-							canFillSpace(decideBoard, mouseX, mouseY);
-							if (decideBoard->canDecideNextMove()) {}
-							else {
-								// Find the completed board and delete it from the list
-								zIterator = boardZBufferList.begin();
-								int i = 0;
-								while (i < boardZBufferList.size()) {
-									if ((*zIterator)->getInitialX() == decideBoard->getInitialX()) {
-										if ((*zIterator)->getBoardResult() == loss) {
-											playerLives--;
-										}
-
-										boardZBufferList.erase(zIterator);
-										zIterator = boardZBufferList.begin();
-									}
-									if (zIterator != boardZBufferList.end()) {
-										zIterator++;
-									}
-									i++;
-								}
-							}
-						}
-					}
+					playerClick(mouseX, mouseY);
 				}
 				break;
 			default:
@@ -429,4 +572,57 @@ void GameManager::input() {
 		}
 		SDL_GetMouseState(&mouseX, &mouseY); //update locations of mouse
 	}
+}
+
+void GameManager::playerClick(int mouseX, int mouseY) {
+	Board* decideBoard = intersectedBoard(mouseX, mouseY);
+	if (decideBoard == NULL) {
+		return;
+	}
+
+	// Only fill grid if it's the player's turn on that grid
+	if (decideBoard->getBoardTurn() == playerTurn) {
+		if (canFillSpace(decideBoard, mouseX, mouseY)) {
+			audioMixer.play(cuePlayerMark);
+		}
+		if (decideBoard->canDecideNextMove()) {
+			audioMixer.play(cueAIMove);
+		}
+		else {
+			// The board is finished, a loss costs a life. Take it out of play
+			if (decideBoard->getBoardResult() == loss) {
+				playerLives--;
+				audioMixer.play(cueLifeLost);
+			}
+			else {
+				audioMixer.play(cueBoardWon);
+			}
+			deleteBoard(decideBoard);
+		}
+	}
+}
+
+// Clicks a random empty cell on the front board a few times a second, so a benchmark run goes through the
+// same input, AI and board clearing paths a player would
+void GameManager::autoPlay() {
+	TRACK_SUBSYSTEM(subsystemInput);
+
+	const float moveInterval = 0.3f;
+	if (runTime < nextAutoMove || boardCount == 0) {
+		return;
+	}
+	nextAutoMove = runTime + moveInterval;
+
+	Board* board = zBoard(boardCount - 1);
+	int cellUnit = board->getPositionEnd().w / 3;
+	int start = rand() % 9;
+	for (int i = 0; i < 9; i++) {
+		int cell = (start + i) % 9;
+		int x = cell / 3;
+		int y = cell % 3;
+		if (board->getBoardGrid(x, y) == -1) {
+			playerClick(board->getLeftX() + (x * cellUnit) + cellUnit / 2, board->getLeftY() + (y * cellUnit) + cellUnit / 2);
+			return;
+		}
+	}
 }
\ No newline at end of file
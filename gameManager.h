@@ -6,20 +6,28 @@
 #include <SDL.h>
 #include <SDL_image.h>
 #include "board.h"
+#include "gameRules.h"
+#include "resourceTracker.h"
+#include "occlusionBuffer.h"
+#include "scheduler.h"
+#include "audioMixer.h"
+#include "waveScript.h"
+#include "qualityGovernor.h"
 #include <iostream>
+#include <string>
 #include <vector>
 #include <cmath>
 #include <math.h>
-#include <list>
 #include <stdio.h>
 #include <stdlib.h>
 #include <time.h>
 
-const enum gameState {mainMenu, ticTacToe};
+enum gameState {mainMenu, ticTacToe};
 
 class GameManager {
 public:
-	GameManager();
+	// With benchmarkSeconds set the game skips the menu, plays itself for that long and then quits
+	GameManager(float benchmarkSeconds = 0.0f);
 	~GameManager();
 
 	// Main constant update methods
@@ -33,67 +41,113 @@ public:
 
 	// Create a board
 	void gameStart(); // Do things that need to happen when the game starts
-	bool boardTimerIsReady();
-	void spawnBoard();
+	void processTimers(); // Fire board expiry, spawn and wave events that are due
+	void spawnBoard(); // Random position
+	void spawnBoardAt(float x, float y); // 0-1 fractions of the area boards can spawn in
+	void spawnBoard(int posX, int posY);
+	void deleteBoard(Board* board); // Takes it out of the draw order and frees its slot
 
 	// Try filling space
 	bool canFillSpace(Board* board, int mouseX, int mouseY);
+	void playerClick(int mouseX, int mouseY);
+	void autoPlay(); // Benchmark stand-in for the player
 
 	// Draw methods
-	void draw(Board* board, int adjustedWAndH); // Overload for changing size of board
+	void layout(Board* board, int adjustedWAndH); // Changes the size of the board and updates its corners
+	void cullOccludedBoards();
+	void draw(Board* board);
 	void draw(const char* message, int posX, int posY, int r, int g, int b, int size); // Draw overload for text
 
+	// Load an image into a texture, the surface is freed once the texture exists
+	SDL_Texture* loadTexture(std::string fileName);
+	// Downscaled copies of the board texture for drawing small boards cheaply
+	void createBoardMips();
+
 private:
 	gameState currentState;
 	
 	// Game markers
 	const int xMarker = 0;
 	const int oMarker = 1;
-	int playerLives = 5;
+	int playerLives = startingLives;
+
+	// Every board lives in this fixed pool, so spawning is a copy into a free slot and never allocates
+	static const int maxBoards = 64;
+	Board boardPool[maxBoards];
+	bool boardInUse[maxBoards] = {};
 
-	std::vector<Board*> boardZBuffer;
-	std::list<Board*> boardZBufferList;
-	std::list<Board*>::iterator zIterator;
-	std::list<Board*>::reverse_iterator revZIterator;
+	// Draw order as indices into the pool. The front of the z-buffer is drawn first, so the back is the front of the screen
+	int boardZBuffer[maxBoards];
+	int boardCount = 0;
+	Board* zBoard(int index) { return &boardPool[boardZBuffer[index]]; }
 
 	SDL_Renderer* renderer;
 	SDL_Window* window;
 
 	// Setting up all the textures used by GameManager
-	SDL_Texture* xTexture;
-	SDL_Texture* oTexture;
-	SDL_Texture* titleTex;
-	SDL_Texture* livesTextTex;
-	SDL_Texture* num5Tex;
-	SDL_Texture* num4Tex;
-	SDL_Texture* num3Tex;
-	SDL_Texture* num2Tex;
-	SDL_Texture* num1Tex;
+	SDL_Texture* xTexture = NULL;
+	SDL_Texture* oTexture = NULL;
+	SDL_Texture* boardTex = NULL; // Every board is drawn with this
+	static const int boardMipCount = 2;
+	const int boardMipSizes[boardMipCount] = { 150, 75 }; // Largest first
+	SDL_Texture* boardMipTex[boardMipCount] = { NULL, NULL };
+	SDL_Texture* titleTex = NULL;
+	SDL_Texture* livesTextTex = NULL;
+	SDL_Texture* num5Tex = NULL;
+	SDL_Texture* num4Tex = NULL;
+	SDL_Texture* num3Tex = NULL;
+	SDL_Texture* num2Tex = NULL;
+	SDL_Texture* num1Tex = NULL;
 
 	// Used for game updates and shutdown
 	bool running;
 	int count;
 
+	// Scripted benchmark run, 0 when a person is playing
+	float benchmarkSeconds;
+	float nextAutoMove = 0.0f;
+
 	// Handling time and frame counts
 	int frameCount, timerFPS, lastFrame;
-	float runTime;
+	float runTime = 0.0f; // Seconds since SDL started, menu included
+	float gameStartTime = 0.0f; // runTime when the menu was left, difficulty ramps from here
 	float lastBoardSpawn, spawnInterval;
 
 	// Window size
 	const int windowHeight = 600;
 	const int windowWidth = 800;
 
+	// Coverage of boards in front, rebuilt every frame for culling
+	OcclusionBuffer occlusionBuffer{ windowWidth, windowHeight };
+
+	// Trades detail for frame time when boards pile up
+	QualityGovernor qualityGovernor;
+	static const int maxFillRects = 1024;
+	SDL_Rect fillRects[maxFillRects]; // Background left uncovered by boards, for qualityReducedFill
+
 	// Input stuff
 	int mouseX, mouseY;
 	Board* intersectedBoard(int mouseX, int mouseY);
 
 	// SpeedMod is a difficulty modifier for speeding up board spawning
-	float speedMod = 5.0f;
-	float speedRamping = 30.0f; // Affects how quickly speed increases (bigger number = slower ramping)
+	float speedMod = 1.0f;
+	float speedRamping = defaultSpeedRamping;
+
+	// Every board deadline and the next spawn
+	Scheduler scheduler;
+
+	// Sound cues, the game runs silently if it couldn't open
+	AudioMixer audioMixer;
+
+	// Spawn waves from the wave file. Without one the game falls back to a board every spawnInterval
+	WaveRunner waveRunner{ this, scheduler };
 
 	// Initialize some variables we can reuse
 	SDL_Color color;
 
+	// Spawn waves
+	std::string wavesTXT = "sourceData/waves.txt";
+
 	// Title
 	std::string titleJPG = "sourceImages/title.jpg";
 
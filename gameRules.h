@@ -0,0 +1,17 @@
+#pragma once
+
+#ifndef GAME_RULES_H
+#define GAME_RULES_H
+
+// Pacing and lives shared by the game and the headless match server, so both play by the same rules
+
+const int startingLives = 5;
+const float defaultSpawnInterval = 4.0f; // Seconds between boards
+const float defaultSpeedRamping = 30.0f; // Affects how quickly speed increases (bigger number = slower ramping)
+
+// Difficulty modifier for a board spawned at runTime. Board lifetimes are divided by it
+inline float speedModifier(float runTime, float speedRamping) {
+	return (runTime + speedRamping) / speedRamping;
+}
+
+#endif // !GAME_RULES_H
@@ -3,14 +3,28 @@
 #include <SDL.h>
 #include <SDL_image.h>
 #include "gameManager.h"
+#include "resourceTracker.h"
 
 
 // You must include the command line parameters for your main function to be recognized by SDL
 int main(int argc, char** args) {
 
-	// Create the game window
-	GameManager ticTacToll;
+	// --benchmark [seconds] skips the menu and lets the game play itself, so tracked runs need nobody at the keyboard
+	float benchmarkSeconds = 0.0f;
+	for (int i = 1; i < argc; i++) {
+		if (std::string(args[i]) == "--benchmark") {
+			benchmarkSeconds = 90.0f;
+			if (i + 1 < argc && atof(args[i + 1]) > 0.0f) {
+				benchmarkSeconds = (float)atof(args[++i]);
+			}
+		}
+	}
 
-	// End the program
-	return 0;
+	// Create the game window, it's scoped so everything is cleaned up before the tracking report
+	{
+		GameManager ticTacToll(benchmarkSeconds);
+	}
+
+	// End the program. With TRACK_RESOURCES on, a leak or a steady-state frame that allocated fails the run
+	return TRACK_REPORT() ? 0 : 1;
 }
\ No newline at end of file
@@ -0,0 +1,153 @@
+#include "occlusionBuffer.h"
+
+OcclusionBuffer::OcclusionBuffer(int width, int height) : width(width), height(height) {
+	tilesX = (width + tileSize - 1) / tileSize;
+	tilesY = (height + tileSize - 1) / tileSize;
+	if (tilesX > maxTilesX) { tilesX = maxTilesX; }
+	if (tilesY > maxTilesY) { tilesY = maxTilesY; }
+	clear();
+}
+
+void OcclusionBuffer::clear() {
+	for (int row = 0; row < tilesY; row++) {
+		for (int word = 0; word < wordsPerRow; word++) {
+			covered[row][word] = 0;
+		}
+	}
+}
+
+bool OcclusionBuffer::clipToScreen(const SDL_Rect& rect, SDL_Rect& clipped) const {
+	int x1 = rect.x < 0 ? 0 : rect.x;
+	int y1 = rect.y < 0 ? 0 : rect.y;
+	int x2 = rect.x + rect.w > width ? width : rect.x + rect.w;
+	int y2 = rect.y + rect.h > height ? height : rect.y + rect.h;
+	if (x2 <= x1 || y2 <= y1) {
+		return false;
+	}
+
+	clipped.x = x1;
+	clipped.y = y1;
+	clipped.w = x2 - x1;
+	clipped.h = y2 - y1;
+	return true;
+}
+
+void OcclusionBuffer::addOccluder(const SDL_Rect& rect) {
+	SDL_Rect clipped;
+	if (!clipToScreen(rect, clipped)) {
+		return;
+	}
+
+	// Only tiles that are completely inside the rect get marked, so round inwards. Tiles hanging
+	// off the right/bottom of the screen count as covered once the visible part is
+	int firstX = (clipped.x + tileSize - 1) / tileSize;
+	int firstY = (clipped.y + tileSize - 1) / tileSize;
+	int lastX = clipped.x + clipped.w == width ? tilesX - 1 : (clipped.x + clipped.w) / tileSize - 1;
+	int lastY = clipped.y + clipped.h == height ? tilesY - 1 : (clipped.y + clipped.h) / tileSize - 1;
+	if (firstX > lastX || firstY > lastY) {
+		return; // Too small to fully cover a single tile
+	}
+
+	for (int row = firstY; row <= lastY; row++) {
+		coverRow(row, firstX, lastX);
+	}
+}
+
+bool OcclusionBuffer::isOccluded(const SDL_Rect& rect) const {
+	SDL_Rect clipped;
+	if (!clipToScreen(rect, clipped)) {
+		return true; // Nothing on screen to draw
+	}
+
+	// Every tile the rect touches has to be covered, so round outwards
+	int firstX = clipped.x / tileSize;
+	int firstY = clipped.y / tileSize;
+	int lastX = (clipped.x + clipped.w - 1) / tileSize;
+	int lastY = (clipped.y + clipped.h - 1) / tileSize;
+
+	for (int row = firstY; row <= lastY; row++) {
+		if (!rowIsCovered(row, firstX, lastX)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+int OcclusionBuffer::uncoveredRects(SDL_Rect* rects, int maxRects) const {
+	// Rects in [growingStart, count) reach down to the row being scanned and can still grow into it
+	int count = 0;
+	int growingStart = 0;
+
+	for (int row = 0; row < tilesY; row++) {
+		int growingEnd = count;
+		int tile = 0;
+		while (tile < tilesX) {
+			// Find the next run of uncovered tiles
+			if ((covered[row][tile / 64] >> (tile % 64)) & 1) {
+				tile++;
+				continue;
+			}
+			int runStart = tile;
+			while (tile < tilesX && !((covered[row][tile / 64] >> (tile % 64)) & 1)) {
+				tile++;
+			}
+
+			SDL_Rect run;
+			run.x = runStart * tileSize;
+			run.y = row * tileSize;
+			run.w = (tile * tileSize > width ? width : tile * tileSize) - run.x;
+			run.h = ((row + 1) * tileSize > height ? height : (row + 1) * tileSize) - run.y;
+
+			// Grow a rect from the row above if it's the same run, so open areas come out as a few big rects.
+			// Grown rects get swapped to the end of the growing range, which becomes the start of the next one
+			bool merged = false;
+			for (int i = growingStart; i < growingEnd; i++) {
+				if (rects[i].x == run.x && rects[i].w == run.w) {
+					rects[i].h += run.h;
+					SDL_Rect grown = rects[i];
+					rects[i] = rects[growingEnd - 1];
+					rects[growingEnd - 1] = grown;
+					growingEnd--;
+					merged = true;
+					break;
+				}
+			}
+			if (merged) {
+				continue;
+			}
+
+			if (count == maxRects) {
+				return -1;
+			}
+			rects[count++] = run;
+		}
+
+		growingStart = growingEnd;
+	}
+
+	return count;
+}
+
+// Bits for the tiles in [firstTile, lastTile] that fall inside the given word of a row
+uint64_t OcclusionBuffer::tileMask(int word, int firstTile, int lastTile) {
+	int low = firstTile > word * 64 ? firstTile - word * 64 : 0;
+	int high = lastTile < word * 64 + 63 ? lastTile - word * 64 : 63;
+	uint64_t highBits = high == 63 ? ~0ULL : (1ULL << (high + 1)) - 1;
+	return highBits & ~((1ULL << low) - 1);
+}
+
+bool OcclusionBuffer::rowIsCovered(int row, int firstTile, int lastTile) const {
+	for (int word = firstTile / 64; word <= lastTile / 64; word++) {
+		uint64_t mask = tileMask(word, firstTile, lastTile);
+		if ((covered[row][word] & mask) != mask) {
+			return false;
+		}
+	}
+	return true;
+}
+
+void OcclusionBuffer::coverRow(int row, int firstTile, int lastTile) {
+	for (int word = firstTile / 64; word <= lastTile / 64; word++) {
+		covered[row][word] |= tileMask(word, firstTile, lastTile);
+	}
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#ifndef OCCLUSION_BUFFER_H
+#define OCCLUSION_BUFFER_H
+
+#include <SDL.h>
+#include <stdint.h>
+
+/*
+	Coarse coverage buffer for culling boards hidden behind other boards.
+
+	The screen is split into tiles and each tile is one bit. Occluders only mark the tiles they cover
+	completely, and a rect only counts as occluded if every tile it touches is marked, so the test is
+	conservative: something that is even partly visible is never culled.
+
+	Fill it front-to-back: test a rect first, then add it as an occluder for everything behind it.
+*/
+
+class OcclusionBuffer {
+public:
+	OcclusionBuffer(int width, int height);
+
+	void clear();
+	void addOccluder(const SDL_Rect& rect);
+	bool isOccluded(const SDL_Rect& rect) const;
+
+	// Writes rects covering every tile no occluder covers, returns how many. -1 if they don't fit in maxRects
+	int uncoveredRects(SDL_Rect* rects, int maxRects) const;
+
+private:
+	static const int tileSize = 10;
+	static const int maxTilesX = 128;
+	static const int maxTilesY = 128;
+	static const int wordsPerRow = maxTilesX / 64;
+
+	int width, height;
+	int tilesX, tilesY;
+
+	// One bit per tile, set when an occluder fully covers it
+	uint64_t covered[maxTilesY][wordsPerRow];
+
+	// Clamps a rect to the screen, false if nothing is left
+	bool clipToScreen(const SDL_Rect& rect, SDL_Rect& clipped) const;
+	// Tile spans within a single row
+	static uint64_t tileMask(int word, int firstTile, int lastTile);
+	bool rowIsCovered(int row, int firstTile, int lastTile) const;
+	void coverRow(int row, int firstTile, int lastTile);
+};
+
+#endif // !OCCLUSION_BUFFER_H
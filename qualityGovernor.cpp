@@ -0,0 +1,65 @@
+#include "qualityGovernor.h"
+#include <iostream>
+
+QualityGovernor::QualityGovernor(float targetMs) : targetMs(targetMs), frameIndex(0), frameSamples(0), windowTotal(0.0f),
+	level(qualityFull), framesAtLevel(0), levelChanges(0) {
+	for (int i = 0; i < windowSize; i++) {
+		frameTimes[i] = 0.0f;
+	}
+	for (int i = 0; i < qualityLevelCount; i++) {
+		secondsAtLevel[i] = 0.0f;
+	}
+}
+
+const char* QualityGovernor::getLevelName(qualityLevel level) {
+	switch (level) {
+	case qualityFull:
+		return "Full";
+	case qualitySmallMarkers:
+		return "Skip small markers";
+	case qualityMipBoards:
+		return "Mip boards";
+	case qualityReducedFill:
+		return "Reduced fill";
+	default:
+		return "Unknown";
+	}
+}
+
+void QualityGovernor::frameFinished(float frameMs) {
+	secondsAtLevel[level] += frameMs / 1000.0f;
+	framesAtLevel++;
+
+	// Running total over a ring of the last windowSize frames
+	windowTotal += frameMs - frameTimes[frameIndex];
+	frameTimes[frameIndex] = frameMs;
+	frameIndex = (frameIndex + 1) % windowSize;
+	if (frameSamples < windowSize) {
+		frameSamples++;
+		return; // Not enough history to judge yet
+	}
+
+	float average = windowTotal / windowSize;
+	if (average > targetMs * degradeAbove && framesAtLevel >= degradeDwell && level + 1 < qualityLevelCount) {
+		changeLevel((qualityLevel)(level + 1));
+	}
+	else if (average < targetMs * restoreBelow && framesAtLevel >= restoreDwell && level > qualityFull) {
+		changeLevel((qualityLevel)(level - 1));
+	}
+}
+
+void QualityGovernor::changeLevel(qualityLevel newLevel) {
+	std::cout << "Quality: " << getLevelName(level) << " -> " << getLevelName(newLevel)
+		<< " (average frame " << windowTotal / windowSize << "ms, target " << targetMs << "ms)" << std::endl;
+
+	level = newLevel;
+	framesAtLevel = 0;
+	levelChanges++;
+}
+
+void QualityGovernor::report() const {
+	std::cout << "Quality level: " << getLevelName(level) << ", " << levelChanges << " change(s)" << std::endl;
+	for (int i = 0; i < qualityLevelCount; i++) {
+		std::cout << "  " << getLevelName((qualityLevel)i) << ": " << secondsAtLevel[i] << "s" << std::endl;
+	}
+}
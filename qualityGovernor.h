@@ -0,0 +1,59 @@
+#pragma once
+
+#ifndef QUALITY_GOVERNOR_H
+#define QUALITY_GOVERNOR_H
+
+/*
+	Keeps frame time inside a budget by trading away detail when boards pile up.
+
+	Each level keeps everything the level before it dropped:
+	- qualitySmallMarkers: boards smaller than markerMinBoardSize don't draw their X's and O's
+	- qualityMipBoards: small boards are drawn from downscaled copies of the board texture
+	- qualityReducedFill: the background is only filled where boards don't already cover it
+
+	The governor averages recent frame times. It steps down a level when the average runs over budget,
+	and steps back up only when there's plenty of headroom and it has stayed on the level for a while.
+	That gap is the hysteresis that keeps levels from flickering.
+*/
+
+enum qualityLevel { qualityFull, qualitySmallMarkers, qualityMipBoards, qualityReducedFill, qualityLevelCount };
+
+class QualityGovernor {
+public:
+	QualityGovernor(float targetMs = 16.6f);
+
+	// Feed in how long the last frame took, may change the level
+	void frameFinished(float frameMs);
+
+	qualityLevel getLevel() const { return level; }
+	static const char* getLevelName(qualityLevel level);
+
+	// Time spent at each level and how often it changed
+	void report() const;
+
+	// Boards narrower than this (in pixels) skip markers from qualitySmallMarkers down
+	static const int markerMinBoardSize = 90;
+
+private:
+	static const int windowSize = 30;        // Frames in the moving average
+	static const int degradeDwell = windowSize; // Frames on a level before stepping down again
+	static const int restoreDwell = windowSize * 4; // Frames on a level before stepping back up
+
+	float targetMs;
+	const float degradeAbove = 1.1f;  // Step down when the average is over target by this much
+	const float restoreBelow = 0.6f;  // Step up when the average is under target by this much
+
+	float frameTimes[windowSize];
+	int frameIndex;
+	int frameSamples;
+	float windowTotal;
+
+	qualityLevel level;
+	int framesAtLevel;
+	int levelChanges;
+	float secondsAtLevel[qualityLevelCount];
+
+	void changeLevel(qualityLevel newLevel);
+};
+
+#endif // !QUALITY_GOVERNOR_H
@@ -0,0 +1,215 @@
+#include "resourceTracker.h"
+
+#ifdef TRACK_RESOURCES
+
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+
+/*
+
+	NOTES:
+	- Only C++ heap allocations (operator new) are counted. SDL and SDL_image allocate with malloc internally,
+	  which is why surfaces and textures are tracked as live objects instead.
+	- The live object table is a fixed array so the tracker itself never allocates while the game is running.
+
+*/
+
+namespace {
+	// Frames to let the game settle (menu, first loads) before holding the loop to zero allocations
+	const long warmupFrames = 120;
+	const int maxLiveRecords = 4096;
+
+	struct LiveRecord {
+		const void* object;
+		trackedResource kind;
+		const char* file;
+		int line;
+		long frame;
+	};
+
+	const char* subsystemNames[subsystemCount] = { "Other", "Loading", "Spawn", "Tick", "Render", "Input", "AI" };
+	const char* resourceNames[resourceCount] = { "Board", "SDL_Surface", "SDL_Texture" };
+
+	trackedSubsystem currentSubsystem = subsystemOther;
+	bool counting = true;
+	long frameNumber = 0;
+
+	// Allocation counts
+	std::atomic<unsigned long> frameAllocations[subsystemCount];
+	unsigned long totalAllocations[subsystemCount];
+	unsigned long steadyFrames = 0;
+	unsigned long steadyFramesWithAllocations = 0;
+	unsigned long steadyAllocations = 0;
+	unsigned long maxSteadyFrameAllocations = 0;
+
+	// Live object table
+	LiveRecord liveRecords[maxLiveRecords];
+	int liveRecordCount = 0;
+	unsigned long createdCount[resourceCount];
+	unsigned long destroyedCount[resourceCount];
+	unsigned long untrackedCount = 0;
+
+	void countAllocation() {
+		if (counting) {
+			frameAllocations[currentSubsystem].fetch_add(1, std::memory_order_relaxed);
+		}
+	}
+
+	// Loading is a one-off, everything else (spawning included) happens during play and is held to zero
+	bool isPerFrameSubsystem(int subsystem) {
+		return subsystem != subsystemLoading;
+	}
+}
+
+// Replace the global allocation functions so every operator new is counted
+void* operator new(std::size_t size) {
+	countAllocation();
+	if (size == 0) {
+		size = 1;
+	}
+	if (void* memory = std::malloc(size)) {
+		return memory;
+	}
+	throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+	return operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+	countAllocation();
+	return std::malloc(size == 0 ? 1 : size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t& tag) noexcept {
+	return operator new(size, tag);
+}
+
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete[](void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, std::size_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, std::size_t) noexcept { std::free(memory); }
+void operator delete(void* memory, const std::nothrow_t&) noexcept { std::free(memory); }
+void operator delete[](void* memory, const std::nothrow_t&) noexcept { std::free(memory); }
+
+void ResourceTracker::beginFrame() {
+	unsigned long frameTotal = 0;
+	for (int i = 0; i < subsystemCount; i++) {
+		unsigned long count = frameAllocations[i].exchange(0, std::memory_order_relaxed);
+		totalAllocations[i] += count;
+		if (isPerFrameSubsystem(i)) {
+			frameTotal += count;
+		}
+	}
+
+	// Only hold frames to the zero allocation target once we're past the warmup
+	if (frameNumber >= warmupFrames) {
+		steadyFrames++;
+		if (frameTotal > 0) {
+			steadyFramesWithAllocations++;
+			steadyAllocations += frameTotal;
+			if (frameTotal > maxSteadyFrameAllocations) {
+				maxSteadyFrameAllocations = frameTotal;
+			}
+		}
+	}
+
+	frameNumber++;
+}
+
+void ResourceTracker::trackCreate(trackedResource kind, const void* object, const char* file, int line) {
+	if (!object) {
+		return;
+	}
+
+	createdCount[kind]++;
+	if (liveRecordCount == maxLiveRecords) {
+		untrackedCount++;
+		return;
+	}
+
+	LiveRecord& record = liveRecords[liveRecordCount++];
+	record.object = object;
+	record.kind = kind;
+	record.file = file;
+	record.line = line;
+	record.frame = frameNumber;
+}
+
+void ResourceTracker::trackDestroy(trackedResource kind, const void* object) {
+	if (!object) {
+		return;
+	}
+
+	destroyedCount[kind]++;
+	for (int i = 0; i < liveRecordCount; i++) {
+		if (liveRecords[i].object == object && liveRecords[i].kind == kind) {
+			// Swap the last record into this slot, order doesn't matter
+			liveRecords[i] = liveRecords[--liveRecordCount];
+			return;
+		}
+	}
+}
+
+bool ResourceTracker::report() {
+	// Stop counting, printing is allowed to allocate
+	counting = false;
+
+	std::cout << "==== Resource tracking report (" << frameNumber << " frames) ====" << std::endl;
+
+	std::cout << "Heap allocations by subsystem:" << std::endl;
+	for (int i = 0; i < subsystemCount; i++) {
+		totalAllocations[i] += frameAllocations[i].exchange(0);
+		std::cout << "  " << subsystemNames[i] << ": " << totalAllocations[i];
+		if (frameNumber > 0) {
+			std::cout << " (" << (double)totalAllocations[i] / frameNumber << " per frame)";
+		}
+		std::cout << std::endl;
+	}
+
+	std::cout << "Steady-state frames: " << steadyFrames
+		<< ", frames that allocated: " << steadyFramesWithAllocations
+		<< ", allocations: " << steadyAllocations
+		<< ", worst frame: " << maxSteadyFrameAllocations << std::endl;
+
+	std::cout << "Objects created/destroyed:" << std::endl;
+	for (int i = 0; i < resourceCount; i++) {
+		std::cout << "  " << resourceNames[i] << ": " << createdCount[i] << "/" << destroyedCount[i] << std::endl;
+	}
+
+	bool leaked = false;
+	for (int i = 0; i < resourceCount; i++) {
+		leaked = leaked || createdCount[i] != destroyedCount[i];
+	}
+
+	if (leaked) {
+		std::cout << "Leaked objects:" << std::endl;
+		for (int i = 0; i < liveRecordCount; i++) {
+			const LiveRecord& record = liveRecords[i];
+			std::cout << "  " << resourceNames[record.kind] << " " << record.object
+				<< " created at " << record.file << ":" << record.line
+				<< " on frame " << record.frame << std::endl;
+		}
+		if (untrackedCount > 0) {
+			std::cout << "  " << untrackedCount << " more objects were created after the live table filled up" << std::endl;
+		}
+	}
+
+	bool targetMet = steadyFramesWithAllocations == 0 && !leaked;
+	std::cout << "Zero allocations per frame target: " << (targetMet ? "PASS" : "FAIL") << std::endl;
+	return targetMet;
+}
+
+ResourceTracker::SubsystemScope::SubsystemScope(trackedSubsystem subsystem) {
+	previous = currentSubsystem;
+	currentSubsystem = subsystem;
+}
+
+ResourceTracker::SubsystemScope::~SubsystemScope() {
+	currentSubsystem = previous;
+}
+
+#endif // TRACK_RESOURCES
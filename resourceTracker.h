@@ -0,0 +1,64 @@
+#pragma once
+
+#ifndef RESOURCE_TRACKER_H
+#define RESOURCE_TRACKER_H
+
+/*
+	Opt-in allocation and resource tracking.
+
+	Define TRACK_RESOURCES in the project's preprocessor settings to turn it on. When it is off every
+	TRACK_* macro compiles away to nothing and the game pays nothing for it.
+
+	When it is on:
+	- Every operator new is counted against the subsystem that is currently active and against the current frame
+	- Live Boards, SDL_Surfaces and SDL_Textures are recorded with the file/line that created them
+	- TRACK_REPORT() prints leaks and per-frame allocation counts, and returns false if any steady-state
+	  frame allocated. Loading is a one-off, so it's reported but not held to zero. Spawning happens all
+	  through play, so it is.
+	- Run the game with --benchmark to have it start and play itself, so the check needs nobody at the keyboard
+*/
+
+enum trackedSubsystem { subsystemOther, subsystemLoading, subsystemSpawn, subsystemTick, subsystemRender, subsystemInput, subsystemAI, subsystemCount };
+enum trackedResource { resourceBoard, resourceSurface, resourceTexture, resourceCount };
+
+#ifdef TRACK_RESOURCES
+
+class ResourceTracker {
+public:
+	// Closes out the previous frame's allocation counts and starts a new one
+	static void beginFrame();
+
+	// Live object bookkeeping
+	static void trackCreate(trackedResource kind, const void* object, const char* file, int line);
+	static void trackDestroy(trackedResource kind, const void* object);
+
+	// Print everything we know, returns true if the zero allocations per frame target was met
+	static bool report();
+
+	// Attributes allocations to a subsystem for as long as it is alive
+	class SubsystemScope {
+	public:
+		SubsystemScope(trackedSubsystem subsystem);
+		~SubsystemScope();
+	private:
+		trackedSubsystem previous;
+	};
+};
+
+#define TRACK_FRAME() ResourceTracker::beginFrame()
+#define TRACK_SUBSYSTEM(subsystem) ResourceTracker::SubsystemScope trackSubsystemScope(subsystem)
+#define TRACK_CREATE(kind, object) ResourceTracker::trackCreate(kind, object, __FILE__, __LINE__)
+#define TRACK_DESTROY(kind, object) ResourceTracker::trackDestroy(kind, object)
+#define TRACK_REPORT() ResourceTracker::report()
+
+#else
+
+#define TRACK_FRAME()
+#define TRACK_SUBSYSTEM(subsystem)
+#define TRACK_CREATE(kind, object)
+#define TRACK_DESTROY(kind, object)
+#define TRACK_REPORT() true
+
+#endif // TRACK_RESOURCES
+
+#endif // !RESOURCE_TRACKER_H
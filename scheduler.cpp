@@ -0,0 +1,139 @@
+#include "scheduler.h"
+
+Scheduler::Scheduler(int initialCapacity) {
+	// Reserve up front so scheduling doesn't allocate during normal play
+	reserve(initialCapacity);
+}
+
+void Scheduler::reserve(int capacity) {
+	timers.reserve(capacity);
+	heap.reserve(capacity);
+	freeSlots.reserve(capacity);
+}
+
+int Scheduler::schedule(float deadline, scheduledEvent type, void* payload) {
+	int slot;
+	if (!freeSlots.empty()) {
+		slot = freeSlots.back();
+		freeSlots.pop_back();
+	}
+	else {
+		slot = (int)timers.size();
+		timers.push_back(Timer());
+		timers[slot].generation = 0;
+	}
+
+	Timer& timer = timers[slot];
+	timer.deadline = deadline;
+	timer.type = type;
+	timer.payload = payload;
+	timer.heapIndex = (int)heap.size();
+
+	heap.push_back(slot);
+	siftUp(timer.heapIndex);
+
+	return (timer.generation << slotBits) | slot;
+}
+
+void Scheduler::cancel(int handle) {
+	if (handle == invalidTimer) {
+		return;
+	}
+
+	int slot = handle & slotMask;
+	if (slot >= (int)timers.size()) {
+		return;
+	}
+
+	// A stale handle means the timer already fired or was cancelled
+	Timer& timer = timers[slot];
+	if (timer.heapIndex == -1 || timer.generation != (handle >> slotBits)) {
+		return;
+	}
+	removeAt(timer.heapIndex);
+}
+
+bool Scheduler::popDue(float now, scheduledEvent& type, void*& payload) {
+	if (heap.empty() || timers[heap[0]].deadline > now) {
+		return false;
+	}
+
+	Timer& timer = timers[heap[0]];
+	type = timer.type;
+	payload = timer.payload;
+	removeAt(0);
+	return true;
+}
+
+bool Scheduler::nextDeadline(float& deadline) const {
+	if (heap.empty()) {
+		return false;
+	}
+	deadline = timers[heap[0]].deadline;
+	return true;
+}
+
+void Scheduler::clear() {
+	while (!heap.empty()) {
+		removeAt((int)heap.size() - 1);
+	}
+}
+
+void Scheduler::removeAt(int heapIndex) {
+	int slot = heap[heapIndex];
+	int last = (int)heap.size() - 1;
+
+	// Move the last entry into the hole and restore the heap from there
+	if (heapIndex != last) {
+		swapEntries(heapIndex, last);
+	}
+	heap.pop_back();
+	if (heapIndex != last) {
+		siftDown(heapIndex);
+		siftUp(heapIndex);
+	}
+
+	// Bumping the generation invalidates any handles still pointing at this slot
+	timers[slot].heapIndex = -1;
+	timers[slot].generation = (timers[slot].generation + 1) & ((1 << (31 - slotBits)) - 1);
+	freeSlots.push_back(slot);
+}
+
+void Scheduler::swapEntries(int a, int b) {
+	int slot = heap[a];
+	heap[a] = heap[b];
+	heap[b] = slot;
+	timers[heap[a]].heapIndex = a;
+	timers[heap[b]].heapIndex = b;
+}
+
+void Scheduler::siftUp(int heapIndex) {
+	while (heapIndex > 0) {
+		int parent = (heapIndex - 1) / 2;
+		if (!earlier(heapIndex, parent)) {
+			return;
+		}
+		swapEntries(heapIndex, parent);
+		heapIndex = parent;
+	}
+}
+
+void Scheduler::siftDown(int heapIndex) {
+	int size = (int)heap.size();
+	while (true) {
+		int left = heapIndex * 2 + 1;
+		int right = left + 1;
+		int smallest = heapIndex;
+		if (left < size && earlier(left, smallest)) {
+			smallest = left;
+		}
+		if (right < size && earlier(right, smallest)) {
+			smallest = right;
+		}
+		if (smallest == heapIndex) {
+			return;
+		}
+		swapEntries(heapIndex, smallest);
+		heapIndex = smallest;
+	}
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <vector>
+
+/*
+	Owns every deadline in the game: board expiry, board spawning and waking up wave scripts.
+
+	Timers live in a binary min-heap ordered by deadline, so checking for due events is a peek at the top
+	and the cost per frame only depends on how many events actually fire. Each timer remembers its place in
+	the heap, which makes cancelling one (a board won or lost early) O(log n) instead of a search.
+
+	Handles carry a generation count, so cancelling a timer that already fired is a harmless no-op.
+*/
+
+enum scheduledEvent { eventBoardExpiry, eventSpawn, eventWaveResume };
+
+const int invalidTimer = -1;
+
+class Scheduler {
+public:
+	Scheduler(int initialCapacity = 64);
+	// Make room for this many timers so scheduling them doesn't allocate
+	void reserve(int capacity);
+
+	// Returns a handle that can be passed to cancel()
+	int schedule(float deadline, scheduledEvent type, void* payload);
+	void cancel(int handle);
+
+	// Pops the earliest event due at or before now. Returns false once nothing else is due
+	bool popDue(float now, scheduledEvent& type, void*& payload);
+
+	void clear();
+	int pending() const { return (int)heap.size(); }
+	// Earliest deadline still waiting, false if nothing is scheduled
+	bool nextDeadline(float& deadline) const;
+
+private:
+	struct Timer {
+		float deadline;
+		scheduledEvent type;
+		void* payload;
+		int heapIndex; // -1 when the slot is free
+		int generation;
+	};
+
+	// Timer slots are recycled through the free list, the heap holds slot indices
+	std::vector<Timer> timers;
+	std::vector<int> heap;
+	std::vector<int> freeSlots;
+
+	static const int slotBits = 20;
+	static const int slotMask = (1 << slotBits) - 1;
+
+	void removeAt(int heapIndex);
+	void swapEntries(int a, int b);
+	void siftUp(int heapIndex);
+	void siftDown(int heapIndex);
+	bool earlier(int a, int b) const { return timers[heap[a]].deadline < timers[heap[b]].deadline; }
+};
+
+#endif // !SCHEDULER_H
@@ -0,0 +1,271 @@
+#include <algorithm>
+#include <deque>
+#include <iostream>
+#include <vector>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include "matchProtocol.h"
+
+/*
+	Stand-in bot for load testing the match server.
+
+	Usage: botClient [--tcp port | --unix path] [--sessions n] [--connections n] [--seconds n] [--think ms]
+
+	Opens the sessions spread across the connections and plays a random free cell on every board that's
+	waiting for it, after the think time. Sessions that run out of lives are reopened so the load holds steady.
+	Move latency is measured from sending a move to its messageBoardUpdate coming back, and reported as
+	percentiles at the end.
+*/
+
+namespace {
+	struct PendingMove {
+		double due;
+		uint32_t session;
+		uint16_t board;
+		uint32_t grid;
+	};
+
+	struct BotConnection {
+		int fd;
+		std::vector<char> input;
+		std::vector<char> output;
+		size_t outputSent = 0;
+		uint16_t nextSequence = 0;
+		std::vector<double> sentAt = std::vector<double>(65536, 0.0);
+		std::deque<PendingMove> thinking; // Fixed think time, so this stays in due order
+	};
+
+	double monotonicSeconds() {
+		timespec now;
+		clock_gettime(CLOCK_MONOTONIC, &now);
+		return now.tv_sec + now.tv_nsec / 1e9;
+	}
+
+	int connectTo(const char* unixPath, int port) {
+		int fd;
+		if (unixPath) {
+			fd = socket(AF_UNIX, SOCK_STREAM, 0);
+			sockaddr_un address = {};
+			address.sun_family = AF_UNIX;
+			strncpy(address.sun_path, unixPath, sizeof(address.sun_path) - 1);
+			if (connect(fd, (sockaddr*)&address, sizeof(address)) == -1) {
+				close(fd);
+				return -1;
+			}
+		}
+		else {
+			fd = socket(AF_INET, SOCK_STREAM, 0);
+			sockaddr_in address = {};
+			address.sin_family = AF_INET;
+			address.sin_port = htons(port);
+			address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+			if (connect(fd, (sockaddr*)&address, sizeof(address)) == -1) {
+				close(fd);
+				return -1;
+			}
+			int noDelay = 1;
+			setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+		}
+
+		fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+		return fd;
+	}
+
+	void queueMessage(BotConnection& connection, const MatchMessage& message) {
+		const char* bytes = (const char*)&message;
+		connection.output.insert(connection.output.end(), bytes, bytes + sizeof(message));
+	}
+
+	bool flush(BotConnection& connection) {
+		while (connection.outputSent < connection.output.size()) {
+			ssize_t bytes = send(connection.fd, connection.output.data() + connection.outputSent,
+				connection.output.size() - connection.outputSent, MSG_NOSIGNAL);
+			if (bytes == -1) {
+				return errno == EAGAIN || errno == EINTR;
+			}
+			connection.outputSent += bytes;
+		}
+		connection.output.clear();
+		connection.outputSent = 0;
+		return true;
+	}
+
+	void openSession(BotConnection& connection) {
+		MatchMessage message = {};
+		message.type = messageOpenSession;
+		queueMessage(connection, message);
+	}
+
+	// Pick a random empty cell and send it
+	void playMove(BotConnection& connection, const PendingMove& move) {
+		int freeCells[9];
+		int freeCount = 0;
+		for (int cell = 0; cell < 9; cell++) {
+			if (unpackGridCell(move.grid, cell) == -1) {
+				freeCells[freeCount++] = cell;
+			}
+		}
+		if (freeCount == 0) {
+			return;
+		}
+
+		MatchMessage message = {};
+		message.type = messageMove;
+		message.session = move.session;
+		message.board = move.board;
+		message.cell = (uint8_t)freeCells[rand() % freeCount];
+		message.sequence = connection.nextSequence++;
+		connection.sentAt[message.sequence] = monotonicSeconds();
+		queueMessage(connection, message);
+	}
+
+	double percentile(const std::vector<float>& sorted, double fraction) {
+		if (sorted.empty()) {
+			return 0.0;
+		}
+		size_t index = (size_t)(fraction * (sorted.size() - 1));
+		return sorted[index];
+	}
+}
+
+int main(int argc, char** args) {
+	const char* unixPath = "/tmp/tictactoll.sock";
+	int port = 0;
+	int sessionCount = 1000;
+	int connectionCount = 8;
+	double seconds = 20.0;
+	double thinkTime = 0.0;
+
+	for (int i = 1; i + 1 < argc; i += 2) {
+		if (strcmp(args[i], "--tcp") == 0) { port = atoi(args[i + 1]); unixPath = NULL; }
+		else if (strcmp(args[i], "--unix") == 0) { unixPath = args[i + 1]; }
+		else if (strcmp(args[i], "--sessions") == 0) { sessionCount = atoi(args[i + 1]); }
+		else if (strcmp(args[i], "--connections") == 0) { connectionCount = atoi(args[i + 1]); }
+		else if (strcmp(args[i], "--seconds") == 0) { seconds = atof(args[i + 1]); }
+		else if (strcmp(args[i], "--think") == 0) { thinkTime = atof(args[i + 1]) / 1000.0; }
+		else {
+			std::cout << "Usage: " << args[0] << " [--tcp port | --unix path] [--sessions n] [--connections n] [--seconds n] [--think ms]" << std::endl;
+			return EXIT_FAILURE;
+		}
+	}
+	if (connectionCount < 1) { connectionCount = 1; }
+	if (connectionCount > sessionCount) { connectionCount = sessionCount; }
+
+	int epollFd = epoll_create1(0);
+	std::vector<BotConnection> connections(connectionCount);
+	for (int i = 0; i < connectionCount; i++) {
+		connections[i].fd = connectTo(unixPath, port);
+		if (connections[i].fd == -1) {
+			std::cout << "Could not connect to the match server. Error: " << strerror(errno) << std::endl;
+			return EXIT_FAILURE;
+		}
+
+		epoll_event event = {};
+		event.events = EPOLLIN;
+		event.data.u32 = i;
+		epoll_ctl(epollFd, EPOLL_CTL_ADD, connections[i].fd, &event);
+
+		// Spread the sessions as evenly as possible
+		int sessionsHere = sessionCount / connectionCount + (i < sessionCount % connectionCount ? 1 : 0);
+		for (int s = 0; s < sessionsHere; s++) {
+			openSession(connections[i]);
+		}
+		flush(connections[i]);
+	}
+
+	std::vector<float> latencies; // Microseconds
+	latencies.reserve(1 << 20);
+	uint64_t boardsWon = 0, boardsLost = 0, boardsExpired = 0, sessionsOver = 0, errors = 0;
+
+	double start = monotonicSeconds();
+	double end = start + seconds;
+	epoll_event events[64];
+	char buffer[64 * 1024];
+
+	while (monotonicSeconds() < end) {
+		int count = epoll_wait(epollFd, events, 64, 1);
+		double now = monotonicSeconds();
+
+		for (int e = 0; e < count; e++) {
+			BotConnection& connection = connections[events[e].data.u32];
+			ssize_t bytes;
+			while ((bytes = read(connection.fd, buffer, sizeof(buffer))) > 0) {
+				connection.input.insert(connection.input.end(), buffer, buffer + bytes);
+			}
+			if (bytes == 0) {
+				std::cout << "Server closed the connection" << std::endl;
+				return EXIT_FAILURE;
+			}
+
+			size_t offset = 0;
+			for (; offset + sizeof(MatchMessage) <= connection.input.size(); offset += sizeof(MatchMessage)) {
+				MatchMessage message;
+				memcpy(&message, connection.input.data() + offset, sizeof(message));
+
+				switch (message.type) {
+				case messageBoardUpdate:
+					latencies.push_back((float)((now - connection.sentAt[message.sequence]) * 1e6));
+					if (message.status == statusWon) { boardsWon++; }
+					if (message.status == statusLost) { boardsLost++; }
+					if (message.status != statusPlayerTurn) { break; }
+					// Still going, take another turn
+					connection.thinking.push_back({ now + thinkTime, message.session, message.board, message.grid });
+					break;
+				case messageBoardSpawned:
+					connection.thinking.push_back({ now + thinkTime, message.session, message.board, message.grid });
+					break;
+				case messageBoardExpired:
+					boardsExpired++;
+					break;
+				case messageSessionOver:
+					sessionsOver++;
+					openSession(connection);
+					break;
+				case messageError:
+					errors++;
+					break;
+				default:
+					break;
+				}
+			}
+			connection.input.erase(connection.input.begin(), connection.input.begin() + offset);
+		}
+
+		// Play whatever's done thinking and send it all
+		for (BotConnection& connection : connections) {
+			while (!connection.thinking.empty() && connection.thinking.front().due <= now) {
+				playMove(connection, connection.thinking.front());
+				connection.thinking.pop_front();
+			}
+			if (!flush(connection)) {
+				std::cout << "Lost the connection to the match server" << std::endl;
+				return EXIT_FAILURE;
+			}
+		}
+	}
+
+	std::sort(latencies.begin(), latencies.end());
+	double elapsed = monotonicSeconds() - start;
+	std::cout << sessionCount << " sessions over " << connectionCount << " connections for " << elapsed << "s" << std::endl;
+	std::cout << "Moves: " << latencies.size() << " (" << latencies.size() / elapsed << "/s), errors: " << errors << std::endl;
+	std::cout << "Boards won: " << boardsWon << ", lost: " << boardsLost << ", expired: " << boardsExpired
+		<< ", sessions over: " << sessionsOver << std::endl;
+	std::cout << "Move latency (us) p50: " << percentile(latencies, 0.50) << ", p99: " << percentile(latencies, 0.99)
+		<< ", p99.9: " << percentile(latencies, 0.999) << ", max: " << (latencies.empty() ? 0.0 : latencies.back()) << std::endl;
+
+	for (BotConnection& connection : connections) {
+		close(connection.fd);
+	}
+	close(epollFd);
+	return EXIT_SUCCESS;
+}
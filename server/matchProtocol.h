@@ -0,0 +1,48 @@
+#pragma once
+
+#ifndef MATCH_PROTOCOL_H
+#define MATCH_PROTOCOL_H
+
+#include <stdint.h>
+
+/*
+	Wire protocol between the match server and bot clients.
+
+	Every message is a fixed 16 byte MatchMessage in both directions, so there's no framing beyond counting
+	bytes. Fields are in host byte order since the server only listens on localhost/Unix sockets.
+
+	Client -> server: messageOpenSession, messageMove (session, board, cell, sequence), messageCloseSession
+	Server -> client: messageSessionOpened, messageBoardSpawned, messageBoardUpdate (reply to a move, echoes
+	                  its sequence), messageBoardExpired, messageSessionOver, messageError (echoes the sequence)
+*/
+
+enum matchMessageType : uint8_t {
+	messageOpenSession, messageMove, messageCloseSession,
+	messageSessionOpened, messageBoardSpawned, messageBoardUpdate, messageBoardExpired, messageSessionOver, messageError
+};
+
+enum matchBoardStatus : uint8_t { statusPlayerTurn, statusWon, statusLost, statusExpired };
+
+struct MatchMessage {
+	uint8_t type;
+	uint8_t lives;
+	uint16_t board;
+	uint32_t session;
+	uint32_t grid;      // 2 bits per cell, cell index x * 3 + y. 0 empty, 1 X, 2 O
+	uint8_t cell;       // Moves only, x * 3 + y
+	uint8_t status;     // matchBoardStatus
+	uint16_t sequence;  // Picked by the client on moves and echoed back
+};
+
+static_assert(sizeof(MatchMessage) == 16, "MatchMessage is a fixed 16 byte frame");
+
+// Grid packing, boardGrid values are -1 empty, 0 X, 1 O
+inline uint32_t packGridCell(int value, int cell) {
+	return (uint32_t)(value + 1) << (cell * 2);
+}
+
+inline int unpackGridCell(uint32_t grid, int cell) {
+	return (int)((grid >> (cell * 2)) & 3) - 1;
+}
+
+#endif // !MATCH_PROTOCOL_H
@@ -0,0 +1,394 @@
+#include "matchServer.h"
+#include "matchSession.h"
+#include <iostream>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <time.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+namespace {
+	const int maxEvents = 256;
+	const int readChunk = 64 * 1024;
+
+	double monotonicSeconds() {
+		timespec now;
+		clock_gettime(CLOCK_MONOTONIC, &now);
+		return now.tv_sec + now.tv_nsec / 1e9;
+	}
+
+	bool setNonBlocking(int fd) {
+		int flags = fcntl(fd, F_GETFL, 0);
+		return flags != -1 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) != -1;
+	}
+}
+
+MatchServer::MatchServer() : running(false), nextSessionId(1), scheduler(1 << 16), movesHandled(0), sessionsOpened(0), peakSessions(0) {
+	epollFd = epoll_create1(0);
+	startTime = monotonicSeconds();
+}
+
+MatchServer::~MatchServer() {
+	while (!connections.empty()) {
+		closeConnection(connections.begin()->second);
+	}
+	for (MatchConnection* connection : closedConnections) {
+		delete connection;
+	}
+
+	for (int listener : listeners) {
+		close(listener);
+	}
+	for (const char* path : unixPaths) {
+		unlink(path);
+	}
+	close(epollFd);
+}
+
+float MatchServer::now() const {
+	return (float)(monotonicSeconds() - startTime);
+}
+
+bool MatchServer::listenTcp(int port) {
+	int fd = socket(AF_INET, SOCK_STREAM, 0);
+	if (fd == -1) {
+		return false;
+	}
+
+	int reuse = 1;
+	setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+	sockaddr_in address = {};
+	address.sin_family = AF_INET;
+	address.sin_port = htons(port);
+	address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+	if (bind(fd, (sockaddr*)&address, sizeof(address)) == -1 || listen(fd, SOMAXCONN) == -1) {
+		std::cout << "Could not listen on port " << port << ". Error: " << strerror(errno) << std::endl;
+		close(fd);
+		return false;
+	}
+	return addListener(fd);
+}
+
+bool MatchServer::listenUnix(const char* path) {
+	int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (fd == -1) {
+		return false;
+	}
+
+	sockaddr_un address = {};
+	address.sun_family = AF_UNIX;
+	strncpy(address.sun_path, path, sizeof(address.sun_path) - 1);
+	unlink(path);
+
+	if (bind(fd, (sockaddr*)&address, sizeof(address)) == -1 || listen(fd, SOMAXCONN) == -1) {
+		std::cout << "Could not listen on " << path << ". Error: " << strerror(errno) << std::endl;
+		close(fd);
+		return false;
+	}
+	unixPaths.push_back(path);
+	return addListener(fd);
+}
+
+bool MatchServer::addListener(int fd) {
+	setNonBlocking(fd);
+
+	epoll_event event = {};
+	event.events = EPOLLIN;
+	event.data.fd = fd;
+	if (epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event) == -1) {
+		close(fd);
+		return false;
+	}
+	listeners.push_back(fd);
+	return true;
+}
+
+void MatchServer::run() {
+	epoll_event events[maxEvents];
+	running = true;
+
+	while (running) {
+		// Sleep until the next session timer is due, or a second if nothing is scheduled
+		int timeoutMs = 1000;
+		float deadline;
+		if (scheduler.nextDeadline(deadline)) {
+			float wait = deadline - now();
+			timeoutMs = wait <= 0.0f ? 0 : (int)(wait * 1000.0f) + 1;
+			if (timeoutMs > 1000) {
+				timeoutMs = 1000;
+			}
+		}
+
+		int count = epoll_wait(epollFd, events, maxEvents, timeoutMs);
+		if (count == -1 && errno != EINTR) {
+			std::cout << "epoll_wait failed. Error: " << strerror(errno) << std::endl;
+			break;
+		}
+
+		for (int i = 0; i < count; i++) {
+			int fd = events[i].data.fd;
+			bool isListener = false;
+			for (int listener : listeners) {
+				isListener = isListener || listener == fd;
+			}
+			if (isListener) {
+				acceptClients(fd);
+				continue;
+			}
+
+			std::unordered_map<int, MatchConnection*>::iterator found = connections.find(fd);
+			if (found == connections.end()) {
+				continue;
+			}
+			MatchConnection* connection = found->second;
+
+			if (events[i].events & (EPOLLERR | EPOLLHUP)) {
+				closeConnection(connection);
+				continue;
+			}
+			if (events[i].events & EPOLLIN) {
+				readFrom(connection);
+			}
+			if ((events[i].events & EPOLLOUT) && !connection->closed) {
+				flush(connection);
+			}
+		}
+
+		processTimers();
+
+		// Write out everything this loop produced, one write per connection
+		for (MatchConnection* connection : flushList) {
+			connection->queued = false;
+			if (!connection->closed) {
+				flush(connection);
+			}
+		}
+		flushList.clear();
+
+		for (MatchConnection* connection : closedConnections) {
+			delete connection;
+		}
+		closedConnections.clear();
+	}
+
+	std::cout << "Match server stopped. Sessions opened: " << sessionsOpened << ", peak concurrent: " << peakSessions
+		<< ", moves handled: " << movesHandled << std::endl;
+}
+
+void MatchServer::acceptClients(int listener) {
+	while (true) {
+		int fd = accept(listener, NULL, NULL);
+		if (fd == -1) {
+			return; // EAGAIN once the backlog is empty
+		}
+
+		setNonBlocking(fd);
+		int noDelay = 1;
+		setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay)); // Fails harmlessly on Unix sockets
+
+		epoll_event event = {};
+		event.events = EPOLLIN;
+		event.data.fd = fd;
+		if (epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event) == -1) {
+			close(fd);
+			continue;
+		}
+
+		MatchConnection* connection = new MatchConnection;
+		connection->fd = fd;
+		connections[fd] = connection;
+	}
+}
+
+void MatchServer::readFrom(MatchConnection* connection) {
+	char buffer[readChunk];
+
+	while (!connection->closed) {
+		ssize_t bytes = read(connection->fd, buffer, sizeof(buffer));
+		if (bytes == 0 || (bytes == -1 && errno != EAGAIN && errno != EINTR)) {
+			closeConnection(connection);
+			return;
+		}
+		if (bytes == -1) {
+			return; // Drained
+		}
+
+		// Handle whole messages straight out of the buffer, only keep a partial one around
+		size_t offset = 0;
+		MatchMessage message;
+		if (!connection->input.empty()) {
+			size_t missing = sizeof(MatchMessage) - connection->input.size();
+			if ((size_t)bytes < missing) {
+				connection->input.insert(connection->input.end(), buffer, buffer + bytes);
+				continue;
+			}
+			connection->input.insert(connection->input.end(), buffer, buffer + missing);
+			memcpy(&message, connection->input.data(), sizeof(message));
+			connection->input.clear();
+			handle(connection, message);
+			offset = missing;
+		}
+
+		while (offset + sizeof(MatchMessage) <= (size_t)bytes && !connection->closed) {
+			memcpy(&message, buffer + offset, sizeof(message));
+			handle(connection, message);
+			offset += sizeof(MatchMessage);
+		}
+		connection->input.insert(connection->input.end(), buffer + offset, buffer + bytes);
+	}
+}
+
+void MatchServer::handle(MatchConnection* connection, const MatchMessage& message) {
+	switch (message.type) {
+	case messageOpenSession: {
+		uint32_t id = nextSessionId++;
+		MatchSession* session = new MatchSession(this, connection, id, now());
+		sessions[id] = session;
+		connection->sessions.push_back(id);
+		sessionsOpened++;
+		if (sessions.size() > peakSessions) {
+			peakSessions = sessions.size();
+		}
+		break;
+	}
+	case messageMove:
+	case messageCloseSession: {
+		// Sessions can only be driven by the connection that opened them
+		std::unordered_map<uint32_t, MatchSession*>::iterator found = sessions.find(message.session);
+		if (found == sessions.end() || found->second->getConnection() != connection) {
+			MatchMessage error = message;
+			error.type = messageError;
+			send(connection, error);
+			break;
+		}
+
+		MatchSession* session = found->second;
+		if (message.type == messageMove) {
+			session->move(message.board, message.cell, message.sequence);
+			movesHandled++;
+		}
+		if (message.type == messageCloseSession || session->isOver()) {
+			closeSession(session);
+		}
+		break;
+	}
+	default: {
+		MatchMessage error = message;
+		error.type = messageError;
+		send(connection, error);
+		break;
+	}
+	}
+}
+
+void MatchServer::processTimers() {
+	float currentTime = now();
+	scheduledEvent type;
+	void* payload;
+
+	while (scheduler.popDue(currentTime, type, payload)) {
+		MatchSession* session;
+		switch (type) {
+		case eventSpawn:
+			session = (MatchSession*)payload;
+			session->spawnBoard(currentTime);
+			break;
+		case eventBoardExpiry:
+			session = ((MatchSession::BoardSlot*)payload)->session;
+			session->expireBoard(payload);
+			break;
+		default:
+			continue;
+		}
+
+		if (session->isOver()) {
+			closeSession(session);
+		}
+	}
+}
+
+void MatchServer::send(MatchConnection* connection, const MatchMessage& message) {
+	if (connection->closed) {
+		return;
+	}
+
+	const char* bytes = (const char*)&message;
+	connection->output.insert(connection->output.end(), bytes, bytes + sizeof(message));
+	if (!connection->queued) {
+		connection->queued = true;
+		flushList.push_back(connection);
+	}
+}
+
+void MatchServer::flush(MatchConnection* connection) {
+	while (connection->outputSent < connection->output.size()) {
+		ssize_t bytes = ::send(connection->fd, connection->output.data() + connection->outputSent,
+			connection->output.size() - connection->outputSent, MSG_NOSIGNAL);
+		if (bytes == -1) {
+			if (errno == EINTR) {
+				continue;
+			}
+			if (errno == EAGAIN) {
+				break;
+			}
+			closeConnection(connection);
+			return;
+		}
+		connection->outputSent += bytes;
+	}
+
+	bool drained = connection->outputSent == connection->output.size();
+	if (drained) {
+		connection->output.clear();
+		connection->outputSent = 0;
+	}
+
+	// Only ask epoll about writability while there's a backlog
+	if (drained == connection->waitingToWrite) {
+		connection->waitingToWrite = !drained;
+		epoll_event event = {};
+		event.events = drained ? EPOLLIN : (EPOLLIN | EPOLLOUT);
+		event.data.fd = connection->fd;
+		epoll_ctl(epollFd, EPOLL_CTL_MOD, connection->fd, &event);
+	}
+}
+
+void MatchServer::closeSession(MatchSession* session) {
+	MatchConnection* connection = session->getConnection();
+	for (size_t i = 0; i < connection->sessions.size(); i++) {
+		if (connection->sessions[i] == session->getId()) {
+			connection->sessions[i] = connection->sessions.back();
+			connection->sessions.pop_back();
+			break;
+		}
+	}
+
+	sessions.erase(session->getId());
+	delete session;
+}
+
+void MatchServer::closeConnection(MatchConnection* connection) {
+	if (connection->closed) {
+		return;
+	}
+	connection->closed = true;
+
+	while (!connection->sessions.empty()) {
+		closeSession(sessions[connection->sessions.back()]);
+	}
+
+	epoll_ctl(epollFd, EPOLL_CTL_DEL, connection->fd, NULL);
+	close(connection->fd);
+	connections.erase(connection->fd);
+
+	// It may still be in the flush list, so it's deleted at the end of the loop
+	closedConnections.push_back(connection);
+}
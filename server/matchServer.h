@@ -0,0 +1,83 @@
+#pragma once
+
+#ifndef MATCH_SERVER_H
+#define MATCH_SERVER_H
+
+#include <stdint.h>
+#include <signal.h>
+#include <vector>
+#include <unordered_map>
+#include "../scheduler.h"
+#include "matchProtocol.h"
+
+class MatchSession;
+
+// A client socket. One connection can host any number of sessions
+struct MatchConnection {
+	int fd;
+	std::vector<char> input;   // Bytes of a message that hasn't fully arrived yet
+	std::vector<char> output;  // Bytes waiting to go out
+	size_t outputSent = 0;
+	std::vector<uint32_t> sessions;
+	bool queued = false;       // Already in the flush list this loop
+	bool waitingToWrite = false; // Registered for EPOLLOUT because the socket was full
+	bool closed = false;
+};
+
+/*
+	Headless multi-session server for load testing the AI against bot clients. Linux only.
+
+	A single thread runs an epoll loop over the listening sockets and every client. Timers for all sessions
+	share one Scheduler, and epoll_wait sleeps until whichever deadline is next. Replies are buffered per
+	connection and written once per loop, so a burst of moves costs one write instead of one per message.
+*/
+
+class MatchServer {
+public:
+	MatchServer();
+	~MatchServer();
+
+	// Localhost only, the protocol isn't meant for the open network
+	bool listenTcp(int port);
+	bool listenUnix(const char* path);
+
+	// Runs until stop() is called, e.g. from a signal handler
+	void run();
+	void stop() { running = false; }
+
+	Scheduler& getScheduler() { return scheduler; }
+	void send(MatchConnection* connection, const MatchMessage& message);
+
+private:
+	int epollFd;
+	std::vector<int> listeners;
+	std::vector<const char*> unixPaths;
+	volatile sig_atomic_t running;
+	double startTime;
+
+	std::unordered_map<int, MatchConnection*> connections;
+	std::unordered_map<uint32_t, MatchSession*> sessions;
+	uint32_t nextSessionId;
+	Scheduler scheduler;
+
+	// Connections with output to write this loop, and ones waiting to be deleted once nothing points at them
+	std::vector<MatchConnection*> flushList;
+	std::vector<MatchConnection*> closedConnections;
+
+	// Stats for the report when the server stops
+	uint64_t movesHandled;
+	uint64_t sessionsOpened;
+	size_t peakSessions;
+
+	float now() const;
+	bool addListener(int fd);
+	void acceptClients(int listener);
+	void readFrom(MatchConnection* connection);
+	void handle(MatchConnection* connection, const MatchMessage& message);
+	void processTimers();
+	void flush(MatchConnection* connection);
+	void closeSession(MatchSession* session);
+	void closeConnection(MatchConnection* connection);
+};
+
+#endif // !MATCH_SERVER_H
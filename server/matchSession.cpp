@@ -0,0 +1,124 @@
+#include "matchSession.h"
+#include "matchServer.h"
+#include "../gameRules.h"
+
+MatchSession::MatchSession(MatchServer* server, MatchConnection* connection, uint32_t id, float now)
+	: server(server), connection(connection), id(id), lives(startingLives), startTime(now), speedMod(1.0f), nextBoardId(0) {
+	for (int i = 0; i < maxBoards; i++) {
+		slots[i].session = this;
+		slots[i].active = false;
+		slots[i].id = 0;
+	}
+
+	send(messageSessionOpened, NULL, statusPlayerTurn, 0);
+
+	// Like the game, the first board comes straight away
+	spawnTimer = invalidTimer;
+	spawnBoard(now);
+}
+
+MatchSession::~MatchSession() {
+	server->getScheduler().cancel(spawnTimer);
+	for (int i = 0; i < maxBoards; i++) {
+		if (slots[i].active) {
+			removeBoard(slots[i]);
+		}
+	}
+}
+
+void MatchSession::spawnBoard(float now) {
+	// Queue the next one first, a full session just skips this board
+	spawnTimer = server->getScheduler().schedule(now + defaultSpawnInterval, eventSpawn, this);
+
+	for (int i = 0; i < maxBoards; i++) {
+		BoardSlot& slot = slots[i];
+		if (slot.active) {
+			continue;
+		}
+
+		slot.board = Board();
+		slot.board.initializeTime(now, speedMod);
+		slot.board.setPlayerTurn();
+		slot.board.setExpiryTimer(server->getScheduler().schedule(slot.board.getTimeEnd(), eventBoardExpiry, &slot));
+		slot.active = true;
+		slot.id = nextBoardId++;
+
+		// Same ramp as GameManager, measured from when the session started
+		speedMod = speedModifier(now - startTime, defaultSpeedRamping);
+
+		send(messageBoardSpawned, &slot, statusPlayerTurn, 0);
+		return;
+	}
+}
+
+void MatchSession::expireBoard(void* payload) {
+	BoardSlot& slot = *(BoardSlot*)payload;
+	send(messageBoardExpired, &slot, statusExpired, 0);
+	removeBoard(slot);
+	loseLife();
+}
+
+void MatchSession::move(uint16_t boardId, int cell, uint16_t sequence) {
+	BoardSlot* slot = findBoard(boardId);
+	if (!slot || cell < 0 || cell > 8 || slot->board.getBoardTurn() != playerTurn || !slot->board.tryPlayerMove(cell / 3, cell % 3)) {
+		send(messageError, slot, statusPlayerTurn, sequence);
+		return;
+	}
+
+	// Same flow as the game: after the player's mark the AI checks for a result or answers
+	if (slot->board.canDecideNextMove()) {
+		send(messageBoardUpdate, slot, statusPlayerTurn, sequence);
+		return;
+	}
+
+	bool won = slot->board.getBoardResult() == win;
+	send(messageBoardUpdate, slot, won ? statusWon : statusLost, sequence);
+	removeBoard(*slot);
+	if (!won) {
+		loseLife();
+	}
+}
+
+MatchSession::BoardSlot* MatchSession::findBoard(uint16_t boardId) {
+	for (int i = 0; i < maxBoards; i++) {
+		if (slots[i].active && slots[i].id == boardId) {
+			return &slots[i];
+		}
+	}
+	return NULL;
+}
+
+void MatchSession::removeBoard(BoardSlot& slot) {
+	server->getScheduler().cancel(slot.board.getExpiryTimer());
+	slot.active = false;
+}
+
+void MatchSession::loseLife() {
+	lives--;
+	if (lives <= 0) {
+		// The server tears the session down once the current event is done with it
+		server->getScheduler().cancel(spawnTimer);
+		spawnTimer = invalidTimer;
+		send(messageSessionOver, NULL, statusLost, 0);
+	}
+}
+
+void MatchSession::send(uint8_t type, const BoardSlot* slot, uint8_t status, uint16_t sequence) {
+	MatchMessage message = {};
+	message.type = type;
+	message.lives = (uint8_t)(lives < 0 ? 0 : lives);
+	message.session = id;
+	message.status = status;
+	message.sequence = sequence;
+
+	if (slot && slot->active) {
+		message.board = slot->id;
+		for (int x = 0; x < 3; x++) {
+			for (int y = 0; y < 3; y++) {
+				message.grid |= packGridCell(slot->board.getBoardGrid(x, y), x * 3 + y);
+			}
+		}
+	}
+
+	server->send(connection, message);
+}
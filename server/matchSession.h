@@ -0,0 +1,66 @@
+#pragma once
+
+#ifndef MATCH_SESSION_H
+#define MATCH_SESSION_H
+
+#include "../board.h"
+#include "../scheduler.h"
+#include "matchProtocol.h"
+
+class MatchServer;
+struct MatchConnection;
+
+/*
+	One headless game: the same Board rules, spawn pacing and lives as GameManager, minus the window.
+
+	Every deadline (next spawn, each board's expiry) goes into the server's shared Scheduler, so a session
+	that's waiting on nothing costs nothing. Boards live by value in a small fixed set of slots, so spawning
+	one never allocates.
+*/
+
+class MatchSession {
+public:
+	MatchSession(MatchServer* server, MatchConnection* connection, uint32_t id, float now);
+	~MatchSession();
+
+	// Handle a move from the client, replies with messageBoardUpdate or messageError
+	void move(uint16_t boardId, int cell, uint16_t sequence);
+
+	// Timer callbacks
+	void spawnBoard(float now);
+	void expireBoard(void* slot);
+
+	uint32_t getId() const { return id; }
+	MatchConnection* getConnection() const { return connection; }
+	bool isOver() const { return lives <= 0; }
+
+	// Scheduler payload for a board expiry, so the session can be found from the timer
+	struct BoardSlot {
+		MatchSession* session;
+		Board board;
+		bool active;
+		uint16_t id;
+	};
+
+private:
+	static const int maxBoards = 8;
+
+	MatchServer* server;
+	MatchConnection* connection;
+	uint32_t id;
+
+	int lives;
+	float startTime;
+	float speedMod;
+	int spawnTimer;
+	uint16_t nextBoardId;
+
+	BoardSlot slots[maxBoards];
+
+	BoardSlot* findBoard(uint16_t boardId);
+	void removeBoard(BoardSlot& slot);
+	void loseLife();
+	void send(uint8_t type, const BoardSlot* slot, uint8_t status, uint16_t sequence);
+};
+
+#endif // !MATCH_SESSION_H
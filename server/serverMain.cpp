@@ -0,0 +1,69 @@
+#include <iostream>
+#include <signal.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sys/resource.h>
+#include "matchServer.h"
+
+/*
+	Headless match server for bot clients.
+
+	Usage: matchServer [--tcp port] [--unix path]
+	With neither, listens on the Unix socket /tmp/tictactoll.sock. Stop it with Ctrl+C to get the stats.
+*/
+
+namespace {
+	MatchServer* activeServer = NULL;
+
+	void handleSignal(int) {
+		if (activeServer) {
+			activeServer->stop();
+		}
+	}
+}
+
+int main(int argc, char** args) {
+	// Lots of sessions can mean lots of clients, lift the descriptor limit as far as we're allowed
+	rlimit limit;
+	if (getrlimit(RLIMIT_NOFILE, &limit) == 0) {
+		limit.rlim_cur = limit.rlim_max;
+		setrlimit(RLIMIT_NOFILE, &limit);
+	}
+
+	// Seed once, the board AI draws from rand() on every move across every session
+	srand(time(NULL));
+
+	MatchServer server;
+	bool listening = false;
+	bool listenedAnywhere = false;
+
+	for (int i = 1; i + 1 < argc; i += 2) {
+		if (strcmp(args[i], "--tcp") == 0) {
+			listening = server.listenTcp(atoi(args[i + 1]));
+		}
+		else if (strcmp(args[i], "--unix") == 0) {
+			listening = server.listenUnix(args[i + 1]);
+		}
+		else {
+			std::cout << "Usage: " << args[0] << " [--tcp port] [--unix path]" << std::endl;
+			return EXIT_FAILURE;
+		}
+		if (!listening) {
+			return EXIT_FAILURE;
+		}
+		listenedAnywhere = true;
+	}
+
+	if (!listenedAnywhere && !server.listenUnix("/tmp/tictactoll.sock")) {
+		return EXIT_FAILURE;
+	}
+
+	activeServer = &server;
+	signal(SIGINT, handleSignal);
+	signal(SIGTERM, handleSignal);
+
+	std::cout << "Match server running" << std::endl;
+	server.run();
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,54 @@
+#include <iostream>
+#include <SDL.h>
+#include "../audioMixer.h"
+
+/*
+	Checks the audio mixer without a sound card.
+
+	Opens the mixer on SDL's dummy audio driver (or whatever SDL_AUDIODRIVER is already set to, e.g. "disk"),
+	plays every cue, waits for the audio callback to pick them all up and closes it again. Exits with 1 if the
+	device wouldn't open, the buffer puts latency over budget or the callback never drained the cues.
+*/
+
+int main(int, char**) {
+	// Don't override a driver that was asked for
+	SDL_setenv("SDL_AUDIODRIVER", "dummy", 0);
+
+	if (SDL_Init(SDL_INIT_AUDIO) < 0) {
+		std::cout << "Could not initialize SDL audio. Error: " << SDL_GetError() << std::endl;
+		return 1;
+	}
+
+	bool passed = true;
+	AudioMixer mixer;
+	if (!mixer.open()) {
+		passed = false;
+	}
+	else {
+		if (mixer.getLatencyMs() > AudioMixer::latencyBudgetMs) {
+			passed = false;
+		}
+
+		for (int i = 0; i < cueCount; i++) {
+			mixer.play((soundCue)i);
+		}
+
+		// The callback runs every few milliseconds, a second is plenty
+		for (int waited = 0; mixer.queuedCues() > 0 && waited < 1000; waited += 10) {
+			SDL_Delay(10);
+		}
+		if (mixer.queuedCues() > 0) {
+			std::cout << mixer.queuedCues() << " cues were never picked up by the audio callback" << std::endl;
+			passed = false;
+		}
+
+		// Let the longest cue play out before closing
+		SDL_Delay(300);
+		mixer.close();
+	}
+
+	SDL_Quit();
+
+	std::cout << "Audio check: " << (passed ? "PASS" : "FAIL") << std::endl;
+	return passed ? 0 : 1;
+}
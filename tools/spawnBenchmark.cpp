@@ -0,0 +1,194 @@
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <list>
+#include <new>
+#include <unordered_map>
+#include <vector>
+#include "../board.h"
+
+/*
+	Measures what it costs to spawn a board, before and after Board became a compact record.
+
+	Three spawn paths are timed, each keeping a handful of boards alive the way the game does:
+	- Legacy: the per-board layout Board had before (rule tables, nested vectors and maps copied into every
+	  instance), heap allocated and linked into a std::list like GameManager used to
+	- Record on the heap: today's Board, still allocated with new and linked into a std::list
+	- Record in a slot: today's Board copied into a preallocated slot, which is what GameManager does now
+
+	Usage: spawnBenchmark [spawns]
+*/
+
+namespace {
+	unsigned long allocationCount = 0;
+
+	// Everything the old Board carried per instance. Only the data matters here, it's what made a spawn expensive
+	struct LegacyBoard {
+		SDL_Rect positionStart;
+		SDL_Rect positionEnd;
+		int initialX, initialY, finalX, finalY = 0;
+		int leftX, leftY, rightX, rightY;
+		const int finalW = 300;
+		const int finalH = 300;
+		SDL_Texture* boardTexture;
+		const int xMarker = 0;
+		const int oMarker = 1;
+		turn boardTurn;
+		int turnCount = 0;
+		int maxTurnCount = 9;
+		boardResult result;
+		float duration = 5.0f;
+		float timeStart, timeEnd;
+		const int solutions[8][3][2] = { { {0,2}, {1,2}, {2,2} },
+										 { {0,1}, {1,1}, {2,1} },
+										 { {0,0}, {1,0}, {2,0} },
+										 { {0,0}, {1,1}, {2,2} },
+										 { {0,0}, {0,1}, {0,2} },
+										 { {1,0}, {1,1}, {1,2} },
+										 { {2,0}, {2,1}, {2,2} },
+										 { {2,0}, {1,1}, {0,2} } };
+		std::vector<std::vector<std::vector<int>>> solutionsVectors { { {0,2}, {1,2}, {2,2} },
+																	 { {0,1}, {1,1}, {2,1} },
+																	 { {0,0}, {1,0}, {2,0} },
+																	 { {0,0}, {1,1}, {2,2} },
+																	 { {0,0}, {0,1}, {0,2} },
+																	 { {1,0}, {1,1}, {1,2} },
+																	 { {2,0}, {2,1}, {2,2} },
+																	 { {2,0}, {1,1}, {0,2} } };
+		std::unordered_map<int, int> solnPriorityMap;
+		std::vector<std::vector<int>> aIMovePriority;
+		const int solutionsTotal = 8;
+		const int lineLength = 3;
+		const int positions[9][2] = { {0,0}, {1,0}, {2,0},
+									  {0,1}, {1,1}, {2,1},
+									  {0,2}, {1,2}, {2,2} };
+		int boardGrid[3][3] = { {-1, -1, -1},
+								{-1, -1, -1},
+								{-1, -1, -1} };
+		int grid[3][3];
+	};
+
+	// Boards on screen at once while spawning
+	const int liveBoards = 8;
+
+	struct Result {
+		double nanoseconds;
+		double allocations;
+	};
+
+	// The old GameManager::spawnBoard, minus loading a texture per board
+	Result spawnLegacy(int spawns) {
+		std::list<LegacyBoard*> boards;
+		unsigned long allocationsBefore = allocationCount;
+		auto start = std::chrono::steady_clock::now();
+
+		for (int i = 0; i < spawns; i++) {
+			if ((int)boards.size() == liveBoards) {
+				LegacyBoard* oldest = boards.back();
+				boards.remove(oldest);
+				delete oldest;
+			}
+
+			LegacyBoard* board = new LegacyBoard;
+			board->timeStart = i * 0.001f;
+			board->timeEnd = board->timeStart + board->duration;
+			board->initialX = i & 511;
+			board->initialY = i & 255;
+			board->positionStart = { 0, 0, board->finalW, board->finalH };
+			board->positionEnd = { board->initialX, board->initialY, 0, 0 };
+			board->leftX = board->rightX = board->initialX;
+			board->leftY = board->rightY = board->initialY;
+			board->boardTurn = playerTurn;
+			boards.push_front(board);
+		}
+
+		auto end = std::chrono::steady_clock::now();
+		Result result = { std::chrono::duration<double, std::nano>(end - start).count() / spawns, (double)(allocationCount - allocationsBefore) / spawns };
+		for (LegacyBoard* board : boards) {
+			delete board;
+		}
+		return result;
+	}
+
+	void setUp(Board& board, int i) {
+		board.initializeTime(i * 0.001f, 1.0f);
+		board.setInitialPos(i & 511, i & 255);
+		board.setPositionEnd(i & 511, i & 255, 0, 0);
+		board.setPlayerTurn();
+	}
+
+	Result spawnRecordOnHeap(int spawns) {
+		std::list<Board*> boards;
+		unsigned long allocationsBefore = allocationCount;
+		auto start = std::chrono::steady_clock::now();
+
+		for (int i = 0; i < spawns; i++) {
+			if ((int)boards.size() == liveBoards) {
+				Board* oldest = boards.back();
+				boards.remove(oldest);
+				delete oldest;
+			}
+
+			Board* board = new Board;
+			setUp(*board, i);
+			boards.push_front(board);
+		}
+
+		auto end = std::chrono::steady_clock::now();
+		Result result = { std::chrono::duration<double, std::nano>(end - start).count() / spawns, (double)(allocationCount - allocationsBefore) / spawns };
+		for (Board* board : boards) {
+			delete board;
+		}
+		return result;
+	}
+
+	// A fresh record copied over the oldest slot, the way GameManager reuses its pool
+	Result spawnRecordInSlot(int spawns) {
+		static Board pool[liveBoards];
+		unsigned long allocationsBefore = allocationCount;
+		auto start = std::chrono::steady_clock::now();
+
+		for (int i = 0; i < spawns; i++) {
+			Board* board = &pool[i % liveBoards];
+			*board = Board();
+			setUp(*board, i);
+		}
+
+		auto end = std::chrono::steady_clock::now();
+		// Stop the compiler from throwing the work away
+		volatile int sink = pool[spawns % liveBoards].getInitialX();
+		(void)sink;
+		return { std::chrono::duration<double, std::nano>(end - start).count() / spawns, (double)(allocationCount - allocationsBefore) / spawns };
+	}
+
+	void print(const char* name, size_t size, const Result& result) {
+		std::cout << name << ": " << size << " bytes, " << result.nanoseconds << "ns and "
+			<< result.allocations << " allocations per spawn" << std::endl;
+	}
+}
+
+// Count every allocation so the report can show what each spawn costs the heap
+void* operator new(std::size_t size) {
+	allocationCount++;
+	if (void* memory = std::malloc(size == 0 ? 1 : size)) {
+		return memory;
+	}
+	throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, std::size_t) noexcept { std::free(memory); }
+
+int main(int argc, char** args) {
+	int spawns = argc > 1 ? atoi(args[1]) : 1000000;
+	if (spawns <= 0) {
+		std::cout << "Usage: spawnBenchmark [spawns]" << std::endl;
+		return 1;
+	}
+
+	std::cout << "Spawning " << spawns << " boards, " << liveBoards << " alive at a time" << std::endl;
+	print("Legacy board, new + std::list", sizeof(LegacyBoard), spawnLegacy(spawns));
+	print("Board record, new + std::list", sizeof(Board), spawnRecordOnHeap(spawns));
+	print("Board record, copied into a slot", sizeof(Board), spawnRecordInSlot(spawns));
+	return 0;
+}
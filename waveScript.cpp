@@ -0,0 +1,303 @@
+#include "waveScript.h"
+#include "gameManager.h"
+#include <fstream>
+#include <sstream>
+#include <iostream>
+
+namespace {
+	// Fixed block arena for coroutine frames. Every wave script is a few locals plus its WaveDefinition,
+	// so one block size fits them all
+	const int arenaBlockSize = 256;
+	const int arenaBlockCount = 4096;
+
+	union ArenaBlock {
+		ArenaBlock* nextFree;
+		alignas(std::max_align_t) unsigned char bytes[arenaBlockSize];
+	};
+
+	ArenaBlock arenaBlocks[arenaBlockCount];
+	ArenaBlock* arenaFreeList = nullptr;
+	bool arenaReady = false;
+	std::size_t oversizedFrame = 0; // Size of the last frame that didn't fit in a block, so start() can say why
+
+	void initializeArena() {
+		for (int i = 0; i < arenaBlockCount - 1; i++) {
+			arenaBlocks[i].nextFree = &arenaBlocks[i + 1];
+		}
+		arenaBlocks[arenaBlockCount - 1].nextFree = nullptr;
+		arenaFreeList = &arenaBlocks[0];
+		arenaReady = true;
+	}
+
+	// Wave scripts. Each one just spawns and waits, the runner and scheduler deal with the timing
+	WaveTask randomWave(WaveRunner& runner, WaveDefinition wave) {
+		for (int i = 0; wave.count == 0 || i < wave.count; i++) {
+			runner.spawnRandom();
+			co_await runner.wait(wave.every);
+		}
+	}
+
+	WaveTask burstWave(WaveRunner& runner, WaveDefinition wave) {
+		for (int i = 0; i < wave.count; i++) {
+			runner.spawnRandom();
+			co_await runner.wait(wave.gap);
+		}
+	}
+
+	WaveTask laneWave(WaveRunner& runner, WaveDefinition wave) {
+		for (int i = 0; i < wave.count; i++) {
+			float along = wave.count == 1 ? 0.5f : (float)i / (wave.count - 1);
+			if (wave.x >= 0.0f) {
+				runner.spawnAt(wave.x, along);
+			}
+			else {
+				runner.spawnAt(along, wave.y >= 0.0f ? wave.y : 0.5f);
+			}
+			co_await runner.wait(wave.gap);
+		}
+	}
+
+	WaveTask gridWave(WaveRunner& runner, WaveDefinition wave) {
+		for (int row = 0; row < wave.rows; row++) {
+			for (int column = 0; column < wave.columns; column++) {
+				float x = wave.columns == 1 ? 0.5f : (float)column / (wave.columns - 1);
+				float y = wave.rows == 1 ? 0.5f : (float)row / (wave.rows - 1);
+				runner.spawnAt(x, y);
+				co_await runner.wait(wave.gap);
+			}
+		}
+	}
+
+	WaveTask escalateWave(WaveRunner& runner, WaveDefinition wave) {
+		for (int w = 0; w < wave.waves; w++) {
+			int boards = wave.count + w * wave.step;
+			for (int i = 0; i < boards; i++) {
+				runner.spawnRandom();
+				co_await runner.wait(wave.gap);
+			}
+			co_await runner.wait(wave.every);
+		}
+	}
+
+	WaveTask createWave(WaveRunner& runner, const WaveDefinition& wave) {
+		switch (wave.pattern) {
+		case patternBurst:
+			return burstWave(runner, wave);
+		case patternLane:
+			return laneWave(runner, wave);
+		case patternGrid:
+			return gridWave(runner, wave);
+		case patternEscalate:
+			return escalateWave(runner, wave);
+		default:
+			return randomWave(runner, wave);
+		}
+	}
+}
+
+void* WaveTask::promise_type::operator new(std::size_t size) noexcept {
+	if (!arenaReady) {
+		initializeArena();
+	}
+	// get_return_object_on_allocation_failure takes it from here
+	if (size > sizeof(ArenaBlock)) {
+		oversizedFrame = size;
+		return nullptr;
+	}
+	if (!arenaFreeList) {
+		return nullptr;
+	}
+
+	ArenaBlock* block = arenaFreeList;
+	arenaFreeList = block->nextFree;
+	return block;
+}
+
+void WaveTask::promise_type::operator delete(void* frame, std::size_t) noexcept {
+	ArenaBlock* block = (ArenaBlock*)frame;
+	block->nextFree = arenaFreeList;
+	arenaFreeList = block;
+}
+
+WaveRunner::WaveRunner(GameManager* game, Scheduler& scheduler) : game(game), scheduler(scheduler) {}
+
+WaveRunner::~WaveRunner() {
+	stopAll();
+}
+
+bool WaveRunner::load(std::string fileName, float& spawnInterval, float& speedRamping) {
+	std::ifstream file(fileName);
+	if (!file) {
+		return false;
+	}
+
+	definitions.clear();
+	std::string line;
+	int lineNumber = 0;
+	while (std::getline(file, line)) {
+		lineNumber++;
+
+		// Strip comments and skip blank lines
+		size_t comment = line.find('#');
+		if (comment != std::string::npos) {
+			line.erase(comment);
+		}
+		std::istringstream words(line);
+		std::string command;
+		if (!(words >> command)) {
+			continue;
+		}
+
+		if (command == "interval" || command == "ramp") {
+			// Both have to be positive. A zero interval respawns forever inside one frame, a zero ramp expires
+			// every board the moment it spawns. Bad values leave the previous setting alone
+			float value;
+			if (!(words >> value) || value <= 0.0f) {
+				std::cout << fileName << ":" << lineNumber << ": couldn't read " << command << " \"" << line << "\"" << std::endl;
+			}
+			else if (command == "interval") {
+				spawnInterval = value;
+			}
+			else {
+				speedRamping = value;
+			}
+		}
+		else {
+			WaveDefinition wave;
+			if (parseWave(line, wave)) {
+				definitions.push_back(wave);
+			}
+			else {
+				std::cout << fileName << ":" << lineNumber << ": couldn't read wave \"" << line << "\"" << std::endl;
+			}
+		}
+	}
+
+	return hasWaves();
+}
+
+// <pattern> key=value key=value ...
+bool WaveRunner::parseWave(const std::string& line, WaveDefinition& wave) {
+	std::istringstream words(line);
+	std::string pattern;
+	words >> pattern;
+
+	if (pattern == "random") { wave.pattern = patternRandom; }
+	else if (pattern == "burst") { wave.pattern = patternBurst; }
+	else if (pattern == "lane") { wave.pattern = patternLane; }
+	else if (pattern == "grid") { wave.pattern = patternGrid; }
+	else if (pattern == "escalate") { wave.pattern = patternEscalate; }
+	else { return false; }
+
+	std::string setting;
+	while (words >> setting) {
+		size_t equals = setting.find('=');
+		if (equals == std::string::npos) {
+			return false;
+		}
+
+		std::string key = setting.substr(0, equals);
+		std::istringstream value(setting.substr(equals + 1));
+		bool read;
+		if (key == "at") { read = (bool)(value >> wave.at); }
+		else if (key == "count") { read = (bool)(value >> wave.count); }
+		else if (key == "gap") { read = (bool)(value >> wave.gap); }
+		else if (key == "every") { read = (bool)(value >> wave.every); }
+		else if (key == "x") { read = (bool)(value >> wave.x) && wave.x >= 0.0f && wave.x <= 1.0f; }
+		else if (key == "y") { read = (bool)(value >> wave.y) && wave.y >= 0.0f && wave.y <= 1.0f; }
+		else if (key == "columns") { read = (bool)(value >> wave.columns); }
+		else if (key == "rows") { read = (bool)(value >> wave.rows); }
+		else if (key == "waves") { read = (bool)(value >> wave.waves); }
+		else if (key == "step") { read = (bool)(value >> wave.step); }
+		else { read = false; }
+
+		if (!read) {
+			return false;
+		}
+	}
+
+	// A wave that never waits would spin forever inside one frame
+	const float shortestWait = 0.05f;
+	if (wave.every < shortestWait) { wave.every = shortestWait; }
+	if (wave.gap < 0.0f) { wave.gap = 0.0f; }
+	return wave.count >= 0 && wave.columns > 0 && wave.rows > 0 && wave.waves >= 0;
+}
+
+void WaveRunner::start(float gameTime) {
+	for (const WaveDefinition& wave : definitions) {
+		WaveTask task = createWave(*this, wave);
+
+		if (!task.handle) {
+			// Debug builds can make frames bigger than a block, which needs arenaBlockSize raised rather than more blocks
+			if (oversizedFrame > 0) {
+				std::cout << "Wave script frame is " << oversizedFrame << " bytes, too big for the " << sizeof(ArenaBlock)
+					<< " byte arena blocks. Raise arenaBlockSize" << std::endl;
+				oversizedFrame = 0;
+			}
+			else {
+				std::cout << "Wave arena is full, " << runningCount << " wave scripts are already running. Raise arenaBlockCount" << std::endl;
+			}
+			continue;
+		}
+
+		// Link it into the live list and schedule its first wake up
+		WaveTask::promise_type& promise = task.handle.promise();
+		promise.runner = this;
+		promise.wakeTime = gameTime + wave.at;
+		promise.next = running;
+		if (running) {
+			running->previous = &promise;
+		}
+		running = &promise;
+		runningCount++;
+
+		scheduler.schedule(promise.wakeTime, eventWaveResume, task.handle.address());
+	}
+}
+
+void WaveRunner::resume(void* payload) {
+	std::coroutine_handle<WaveTask::promise_type> handle = std::coroutine_handle<WaveTask::promise_type>::from_address(payload);
+	handle.resume();
+	if (handle.done()) {
+		destroy(handle);
+	}
+}
+
+// Only call this when nothing is scheduled for the wave, i.e. it finished or the scheduler is being cleared
+void WaveRunner::destroy(std::coroutine_handle<WaveTask::promise_type> handle) {
+	WaveTask::promise_type& promise = handle.promise();
+	if (promise.previous) {
+		promise.previous->next = promise.next;
+	}
+	else {
+		running = promise.next;
+	}
+	if (promise.next) {
+		promise.next->previous = promise.previous;
+	}
+	runningCount--;
+
+	handle.destroy();
+}
+
+// Any pending resumes still point at these frames, so the scheduler has to be cleared along with this
+void WaveRunner::stopAll() {
+	while (running) {
+		destroy(std::coroutine_handle<WaveTask::promise_type>::from_promise(*running));
+	}
+}
+
+void WaveRunner::Delay::await_suspend(std::coroutine_handle<WaveTask::promise_type> handle) const {
+	// Wake relative to the last wake up rather than the current time, so late frames don't add up
+	WaveTask::promise_type& promise = handle.promise();
+	promise.wakeTime += seconds;
+	promise.runner->scheduler.schedule(promise.wakeTime, eventWaveResume, handle.address());
+}
+
+void WaveRunner::spawnRandom() {
+	game->spawnBoard();
+}
+
+void WaveRunner::spawnAt(float x, float y) {
+	game->spawnBoardAt(x, y);
+}
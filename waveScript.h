@@ -0,0 +1,116 @@
+#pragma once
+
+#ifndef WAVE_SCRIPT_H
+#define WAVE_SCRIPT_H
+
+#include <coroutine>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "scheduler.h"
+
+/*
+	Data-driven spawn waves.
+
+	Waves are read from a small text file (see sourceData/waves.txt) so difficulty can be tuned without a
+	rebuild. Each wave runs as a C++20 coroutine that spawns boards and then waits on the game clock:
+	- Waiting schedules a resume with the Scheduler, so a wave that isn't due costs nothing. Thousands of them
+	  can be live and the frame only pays for the ones that wake up
+	- Coroutine frames come out of a fixed block arena that is set aside up front, never the heap
+	- Each wave keeps its own clock and wakes at exact multiples of its delays, so a late frame doesn't push
+	  the rest of the wave back
+*/
+
+class GameManager;
+class WaveRunner;
+
+enum wavePattern { patternRandom, patternBurst, patternLane, patternGrid, patternEscalate };
+
+// One line from the wave file. Positions are 0-1 fractions of the area boards can spawn in
+struct WaveDefinition {
+	wavePattern pattern;
+	float at = 0.0f;      // Seconds after the game starts
+	int count = 1;        // Boards per burst/lane, 0 means forever for random
+	float gap = 0.25f;    // Seconds between boards inside a wave
+	float every = 4.0f;   // Seconds between repeats (random, escalate)
+	float x = -1.0f;      // Vertical lane when set
+	float y = -1.0f;      // Horizontal lane when set
+	int columns = 3;
+	int rows = 2;
+	int waves = 3;        // Escalate only
+	int step = 1;         // Escalate only, extra boards added each wave
+};
+
+// The coroutine type every wave script returns
+class WaveTask {
+public:
+	struct promise_type {
+		WaveRunner* runner = nullptr;
+		float wakeTime = 0.0f;
+
+		// Intrusive list of live waves, so shutting down never needs a container
+		promise_type* previous = nullptr;
+		promise_type* next = nullptr;
+
+		WaveTask get_return_object() { return WaveTask(std::coroutine_handle<promise_type>::from_promise(*this)); }
+		static WaveTask get_return_object_on_allocation_failure() { return WaveTask(nullptr); }
+
+		// Waves start suspended, the runner schedules their first resume
+		std::suspend_always initial_suspend() noexcept { return {}; }
+		std::suspend_always final_suspend() noexcept { return {}; }
+		void return_void() {}
+		void unhandled_exception() { throw; }
+
+		// Frames come from the wave arena instead of the heap
+		static void* operator new(std::size_t size) noexcept;
+		static void operator delete(void* frame, std::size_t size) noexcept;
+	};
+
+	std::coroutine_handle<promise_type> handle;
+
+private:
+	explicit WaveTask(std::coroutine_handle<promise_type> coroutine) : handle(coroutine) {}
+};
+
+class WaveRunner {
+public:
+	WaveRunner(GameManager* game, Scheduler& scheduler);
+	~WaveRunner();
+
+	// Read a wave file. Settings the file doesn't mention keep the values passed in
+	bool load(std::string fileName, float& spawnInterval, float& speedRamping);
+	bool hasWaves() const { return !definitions.empty(); }
+	int getWaveCount() const { return (int)definitions.size(); }
+
+	// Kick off every wave relative to the game starting now
+	void start(float gameTime);
+	// Called by GameManager when an eventWaveResume comes due
+	void resume(void* payload);
+	void stopAll();
+	int getRunningCount() const { return runningCount; }
+
+	// What wave scripts await on. Resumes the wave that many seconds after it last woke
+	struct Delay {
+		float seconds;
+		bool await_ready() const noexcept { return false; }
+		void await_suspend(std::coroutine_handle<WaveTask::promise_type> handle) const;
+		void await_resume() const noexcept {}
+	};
+
+	Delay wait(float seconds) const { return Delay{ seconds }; }
+	void spawnRandom();
+	void spawnAt(float x, float y);
+
+private:
+	GameManager* game;
+	Scheduler& scheduler;
+
+	std::vector<WaveDefinition> definitions;
+	WaveTask::promise_type* running = nullptr;
+	int runningCount = 0;
+
+	bool parseWave(const std::string& line, WaveDefinition& wave);
+	void destroy(std::coroutine_handle<WaveTask::promise_type> handle);
+};
+
+#endif // !WAVE_SCRIPT_H